@@ -15,18 +15,26 @@ AttackSystem::AttackSystem(QtEntity::EntityManager* em)
     : BaseClass(em)
     , _target(0)
 {
+    setSnapshotConverter(&AttackSystem::attackToVariantMap);
 }
 
 
-QVariantMap AttackSystem::toVariantMap(QtEntity::EntityId eid, int)
+QVariantMap AttackSystem::toVariantMap(QtEntity::EntityId eid, int context)
 {
-    QVariantMap m;
     Attack* a;
     if(component(eid, a))
     {
-        m["attackMode"] = QVariant::fromValue(attackMode(eid));
-        m["speed"] = a->_speed;
+        return attackToVariantMap(*a, context);
     }
+    return QVariantMap();
+}
+
+
+QVariantMap AttackSystem::attackToVariantMap(const Attack& a, int)
+{
+    QVariantMap m;
+    m["attackMode"] = QVariant::fromValue(a._attackMode);
+    m["speed"] = a._speed;
     return m;
 }
 
@@ -83,6 +91,7 @@ void AttackSystem::setAttackMode(QtEntity::EntityId eid, AttackMode v)
 
 void AttackSystem::tick(int frameNumber, int totalTime, float delta)
 {
+    QTENTITY_PROFILE_ZONE("AttackSystem::tick");
     Q_UNUSED(frameNumber)
     Q_UNUSED(totalTime)
 
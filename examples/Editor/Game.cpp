@@ -4,6 +4,7 @@
 #include "ParticleEmitterSystem"
 #include "Renderer"
 #include "ShapeSystem"
+#include <QtEntity/Profiler>
 #include <QCoreApplication>
 #include <QTime>
 #include <QThread>
@@ -119,6 +120,7 @@ void Game::createPlayer()
 
 void Game::step(int frameNumber, int totalTime, float delta)
 {
+    QTENTITY_PROFILE_ZONE("Game::step");
 
     //Shape* player;
     //_entityManager.component(_playerid, player);
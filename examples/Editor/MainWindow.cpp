@@ -4,10 +4,15 @@
 #include "Renderer"
 #include <QtEntity/DataTypes>
 #include <QtEntity/EntityManager>
+#include <QtEntity/Profiler>
 #include "ShapeSystem"
 #include <QtEntityUtils/EntityEditor>
+#include <QtEntityUtils/EntityListModel>
+#include <QtEntityUtils/MemoryStatsWidget>
 #include <QtEntityUtils/PrefabSystem>
 #include <QDebug>
+#include <QDockWidget>
+#include <QShortcut>
 
 MainWindow::MainWindow()    
     : _selectedEntity(0)
@@ -30,18 +35,26 @@ MainWindow::MainWindow()
     QtEntityUtils::EntityEditor* editor = new QtEntityUtils::EntityEditor();
     connect(this, &MainWindow::selectedEntityChanged, editor, &QtEntityUtils::EntityEditor::displayEntity);
     connect(this, &MainWindow::selectedEntityChanged, this, &MainWindow::entityChanged);
+    connect(this, &MainWindow::selectedEntitiesChanged, editor, &QtEntityUtils::EntityEditor::displayEntities);
     connect(editor, &QtEntityUtils::EntityEditor::entityDataChanged, this, &MainWindow::changeEntityData);
+    connect(editor, &QtEntityUtils::EntityEditor::entitiesDataChanged, this, &MainWindow::changeEntitiesData);
+    connect(editor, &QtEntityUtils::EntityEditor::entitiesFieldChanged, this, &MainWindow::changeEntitiesField);
+    editor->setLiveUpdate(_game->entityManager());
     _editorPos->setLayout(new QHBoxLayout);
     _editorPos->layout()->addWidget(editor);
 
     ////////////////// entity list ///////////////////////////
-    // connect signals of meta data system to entity list
+    // model is updated once per frame from the signals of the shape system
+    _entityModel = new QtEntityUtils::EntityListModel(_game->entityManager(), this);
+    _entityModel->setNameField("Shape", "name");
+    _entities->setModel(_entityModel);
 
-    connect(_game->shapeSystem(), &ShapeSystem::entityAdded,   this, &MainWindow::entityAdded);
-    connect(_game->shapeSystem(), &ShapeSystem::entityRemoved, this, &MainWindow::entityRemoved);
-    connect(_game->shapeSystem(), &ShapeSystem::entityNameChanged, this, &MainWindow::entityNameChanged);
+    connect(_game->shapeSystem(), &ShapeSystem::entityAdded,   _entityModel, &QtEntityUtils::EntityListModel::entityChanged);
+    connect(_game->shapeSystem(), &ShapeSystem::entityRemoved, _entityModel, &QtEntityUtils::EntityListModel::entityChanged);
+    connect(_game->shapeSystem(), &ShapeSystem::entityNameChanged, _entityModel, &QtEntityUtils::EntityListModel::entityChanged);
+    connect(_entityFilter, &QLineEdit::textChanged, _entityModel, &QtEntityUtils::EntityListModel::setNameFilter);
 
-    connect(_entities, &QTableWidget::itemSelectionChanged, this, &MainWindow::entitySelectionChanged);
+    connect(_entities->selectionModel(), &QItemSelectionModel::selectionChanged, this, &MainWindow::entitySelectionChanged);
 
     ////////////////// prefab menu ///////////////////////////
     connect(_game->prefabSystem(), &QtEntityUtils::PrefabSystem::prefabAdded, this, &MainWindow::prefabAdded);
@@ -51,6 +64,25 @@ MainWindow::MainWindow()
     ////////////////// component buttons ///////////////////////////
     connect(_addComponentButton, &QPushButton::clicked, this, &MainWindow::addComponentButtonClicked);
     connect(_removeComponentButton, &QPushButton::clicked, this, &MainWindow::removeComponentButtonClicked);
+
+    ////////////////// undo / redo ///////////////////////////
+    connect(new QShortcut(QKeySequence::Undo, this), &QShortcut::activated, this, &MainWindow::undo);
+    connect(new QShortcut(QKeySequence::Redo, this), &QShortcut::activated, this, &MainWindow::redo);
+
+    ////////////////// memory stats ///////////////////////////
+    QtEntityUtils::MemoryStatsWidget* memoryStats = new QtEntityUtils::MemoryStatsWidget(_game->entityManager());
+    memoryStats->setRefreshInterval(1000);
+    QDockWidget* memoryDock = new QDockWidget(tr("Memory"), this);
+    memoryDock->setWidget(memoryStats);
+    addDockWidget(Qt::BottomDockWidgetArea, memoryDock);
+
+    ////////////////// profiling ///////////////////////////
+    connect(new QShortcut(QKeySequence(Qt::Key_F12), this), &QShortcut::activated, [this]() {
+        QString path("qtentity_trace.json");
+        bool written = QtEntity::Profiler::writeChromeTrace(path);
+        statusBar()->showMessage(written ? QString("Trace written to %1").arg(path) : QString("Could not write %1").arg(path), 3000);
+    });
+
     adjustSize();
     setFocusPolicy(Qt::StrongFocus);
 
@@ -131,7 +163,13 @@ void MainWindow::addComponentToCurrent(const QString& component)
     QtEntity::EntitySystem* es = _game->entityManager()->system(component);
     if(es)
     {
-        es->createComponent(_selectedEntity);
+        foreach(QtEntity::EntityId id, _selectedEntities)
+        {
+            if(!es->component(id))
+            {
+                es->createComponent(id);
+            }
+        }
     }
     updateEditorWithCurrent();
 
@@ -141,7 +179,22 @@ int frameNumber = 0;
 void MainWindow::stepGame()
 {
     ++frameNumber;
+    QtEntity::Profiler::beginFrame();
     _game->step(frameNumber, frameNumber * 20, 0.02f);
+    QtEntity::Profiler::endFrame();
+
+#ifdef QTENTITY_PROFILING
+    // show most expensive zones of the frame
+    if(frameNumber % 50 == 0)
+    {
+        QStringList zones;
+        foreach(const QtEntity::ProfileZoneStats& s, QtEntity::Profiler::frameSummary().mid(0, 4))
+        {
+            zones.push_back(QString("%1: %2 us").arg(s._name).arg(s._totalNs / 1000));
+        }
+        statusBar()->showMessage(zones.join("   "));
+    }
+#endif
 }
 
 
@@ -151,37 +204,6 @@ void MainWindow::prefabAdded(const QString& prefab)
 }
 
 
-// insert entry into entity list
-void MainWindow::entityAdded(QtEntity::EntityId id, QString name)
-{
-    _entities->setSortingEnabled(false);
-
-    int row = _entities->rowCount();
-    _entities->insertRow(row);
-    auto item = new QTableWidgetItem(QString("%1").arg(id));
-    item->setData(Qt::UserRole, id);
-    _entities->setItem(row, 0, item);
-    _entities->setItem(row, 1, new QTableWidgetItem(name));    
-    _entities->setSortingEnabled(true);
-}
-
-
-// remove entry from entity list
-void MainWindow::entityRemoved(QtEntity::EntityId id)
-{
-    for(int i = 0; i < _entities->rowCount(); ++i)
-    {
-        QTableWidgetItem* item = _entities->item(i, 0);
-        if(item && item->data(Qt::UserRole).toUInt() == id)
-        {
-            _entities->removeRow(i);
-            return;
-        }
-    }
-    qCritical() << "could not remove entity from entity list, not found: " << id;
-}
-
-
 void MainWindow::entityChanged(QtEntity::EntityId id, const QVariantMap& data,
                    const QVariantMap& attributes, const QStringList& availableComponents)
 {
@@ -198,6 +220,14 @@ void MainWindow::updateEditorWithCurrent()
     {
         emit selectedEntityChanged(0, QVariantMap(), QVariantMap(), QStringList());
     }
+    else if(_selectedEntities.size() > 1)
+    {
+        QVariantMap props, attributes;
+        QStringList availableComponents;
+        QtEntityUtils::EntityEditor::fetchEntitiesData(*_game->entityManager(), _selectedEntities, props, attributes, availableComponents);
+        _availableComponents = availableComponents;
+        emit selectedEntitiesChanged(_selectedEntities, props, attributes, availableComponents);
+    }
     else
     {
         QVariantMap props, attributes;
@@ -210,15 +240,12 @@ void MainWindow::updateEditorWithCurrent()
 
 void MainWindow::entitySelectionChanged()
 {
-    auto items = _entities->selectedItems();
-    if(items.empty())
-    {
-        _selectedEntity = 0;
-    }
-    else
+    _selectedEntities.clear();
+    foreach(QModelIndex index, _entities->selectionModel()->selectedRows())
     {
-        _selectedEntity = items.front()->data(Qt::UserRole).toUInt();
+        _selectedEntities.push_back(_entityModel->entityId(index));
     }
+    _selectedEntity = _selectedEntities.empty() ? 0 : _selectedEntities.front();
     updateEditorWithCurrent();
 }
 
@@ -227,6 +254,7 @@ void MainWindow::prefabSelectionChanged(QListWidgetItem * item)
 {
     _addInstance->setEnabled(true);
     _selectedEntity = 0;
+    _selectedEntities.clear();
     QString selected = item->text();
     auto prefab = _game->prefabSystem()->prefab(selected);
     QVariantMap attributes;
@@ -262,36 +290,36 @@ void MainWindow::changeEntityData(QtEntity::EntityId id, const QVariantMap& valu
     }
     else
     {
-        QtEntityUtils::EntityEditor::applyEntityData(*_game->entityManager(), id, values);
+        QtEntityUtils::EntityEditor::applyEntityData(*_game->entityManager(), id, values, &_journal);
     }
 }
 
 
-// update entry in entity list
-void MainWindow::entityNameChanged(QtEntity::EntityId id, QString name)
+void MainWindow::changeEntitiesData(const QList<QtEntity::EntityId>& ids, const QVariantMap& values)
 {
-    _entities->setSortingEnabled(false);
+    QtEntityUtils::EntityEditor::applyEntitiesData(*_game->entityManager(), ids, values, &_journal);
+}
 
-    for(int i = 0; i < _entities->rowCount(); ++i)
+
+void MainWindow::changeEntitiesField(const QList<QtEntity::EntityId>& ids, const QString& componentName, const QString& path, const QVariant& value)
+{
+    QtEntityUtils::EntityEditor::applyEntitiesPatch(*_game->entityManager(), ids, componentName, path, value, &_journal);
+}
+
+
+void MainWindow::undo()
+{
+    if(_journal.undo(*_game->entityManager()))
     {
-        QTableWidgetItem* item = _entities->item(i, 0);
-        if(item && item->data(Qt::UserRole).toUInt() == id)
-        {
-            _entities->item(i, 1)->setText(name);
+        updateEditorWithCurrent();
+    }
+}
 
-            // delete all additional entries before recreating them
-            for(int j = 2; j < _entities->columnCount(); ++j)
-            {
-                QTableWidgetItem* item = _entities->item(i, j);
-                if(item)
-                {
-                    delete _entities->takeItem(i, j);
-                }
-            }
 
-            break;
-        }
+void MainWindow::redo()
+{
+    if(_journal.redo(*_game->entityManager()))
+    {
+        updateEditorWithCurrent();
     }
-    _entities->setSortingEnabled(true);
-    qCritical() << "could not update entity in entity list, not found: " << id;
 }
@@ -13,18 +13,25 @@ ParticleEmitterSystem::ParticleEmitterSystem(QtEntity::EntityManager* em, Render
     : BaseClass(em)
     , _renderer(renderer)
 {
+    setSnapshotConverter(&ParticleEmitterSystem::emitterToVariantMap);
 }
 
 
-QVariantMap ParticleEmitterSystem::toVariantMap(QtEntity::EntityId eid, int)
+QVariantMap ParticleEmitterSystem::toVariantMap(QtEntity::EntityId eid, int context)
 {
-
-    QVariantMap m;
     ParticleEmitter* e;
     if(component(eid, e))
     {
-        m["emitters"] = QVariant::fromValue(e->_emitters);
+        return emitterToVariantMap(*e, context);
     }
+    return QVariantMap();
+}
+
+
+QVariantMap ParticleEmitterSystem::emitterToVariantMap(const ParticleEmitter& e, int)
+{
+    QVariantMap m;
+    m["emitters"] = QVariant::fromValue(e._emitters);
     return m;
 }
 
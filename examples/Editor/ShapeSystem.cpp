@@ -13,6 +13,7 @@ ShapeSystem::ShapeSystem(QtEntity::EntityManager* em, Renderer* renderer)
     : BaseClass(em)
     , _renderer(renderer)
 {
+    setSnapshotConverter(&ShapeSystem::shapeToVariantMap);
 }
 
 
@@ -38,20 +39,26 @@ bool ShapeSystem::destroyComponent(QtEntity::EntityId id)
 }
 
 
-QVariantMap ShapeSystem::toVariantMap(QtEntity::EntityId eid, int)
+QVariantMap ShapeSystem::toVariantMap(QtEntity::EntityId eid, int context)
 {
-    QVariantMap m;
     Shape* s;
     if(component(eid, s))
     {
-        m["name"]     = s->_name;
-        m["position"] = QPointF(s->_position.x(), s->_position.y());
-        m["path"]     = QVariant::fromValue(s->_path);
-        m["zIndex"]   = s->_zindex;
-        m["subTex"]   = s->_subtex;
+        return shapeToVariantMap(*s, context);
     }
+    return QVariantMap();
+}
+
+
+QVariantMap ShapeSystem::shapeToVariantMap(const Shape& s, int)
+{
+    QVariantMap m;
+    m["name"]     = s._name;
+    m["position"] = QPointF(s._position.x(), s._position.y());
+    m["path"]     = QVariant::fromValue(s._path);
+    m["zIndex"]   = s._zindex;
+    m["subTex"]   = s._subtex;
     return m;
-    
 }
 
 
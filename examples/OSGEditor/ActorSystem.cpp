@@ -52,6 +52,31 @@ osg::Vec3d Actor::position() const
 }
 
 
+static osg::ShapeDrawable* createShapeDrawable(const QtEntityUtils::Item& entry)
+{
+    osg::ShapeDrawable* sd = new osg::ShapeDrawable();
+
+    QVariantMap val = entry._value.toMap();
+
+    if(entry._prototype == "Box")
+    {
+        osg::Vec3 hl = toVec(val["HalfLengths"]);
+        osg::Vec3 c = toVec(val["Center"]);
+        sd->setShape(new osg::Box(c, hl[0],hl[1],hl[2]));
+
+    }
+    else if(entry._prototype == "Sphere")
+    {
+        osg::Vec3 c = toVec(val["Center"]);
+        float radius = val["Radius"].toFloat();
+        sd->setShape(new osg::Sphere(c, radius));
+    }
+    QColor co = val["Color"].value<QColor>();
+    sd->setColor(osg::Vec4(co.redF(), co.greenF(), co.blueF(), co.alphaF()));
+    return sd;
+}
+
+
 void Actor::setShapes(const QtEntityUtils::ItemList& shapes)
 {
     _shapes = shapes;
@@ -59,32 +84,25 @@ void Actor::setShapes(const QtEntityUtils::ItemList& shapes)
 
     for(auto i = shapes.begin(); i != shapes.end(); ++i)
     {
-        QtEntityUtils::Item entry = *i;
+        _geode->addDrawable(createShapeDrawable(*i));
+    }
+}
 
-        osg::ref_ptr<osg::ShapeDrawable> sd = new osg::ShapeDrawable();
-        
-        using namespace QtEntity;
 
-        QVariantMap val = entry._value.toMap();
+void Actor::setShape(int index, const QtEntityUtils::Item& shape)
+{
+    _shapes[index] = shape;
+    _geode->setDrawable(index, createShapeDrawable(shape));
+}
 
-        if(entry._prototype == "Box")
-        {
-            osg::Vec3 hl = toVec(val["HalfLengths"]);
-            osg::Vec3 c = toVec(val["Center"]);
-            sd->setShape(new osg::Box(c, hl[0],hl[1],hl[2]));
-            
-        }
-        else if(entry._prototype == "Sphere")
-        {
-            osg::Vec3 c = toVec(val["Center"]);
-            float radius = val["Radius"].toFloat();
-            sd->setShape(new osg::Sphere(c, radius));
-        }
-        QColor co = val["Color"].value<QColor>();
-        sd->setColor(osg::Vec4(co.redF(), co.greenF(), co.blueF(), co.alphaF()));
-        _geode->addDrawable(sd);
 
-    }
+void Actor::setShapeColor(int index, const QColor& co)
+{
+    QVariantMap val = _shapes[index]._value.toMap();
+    val["Color"] = co;
+    _shapes[index]._value = val;
+    osg::ShapeDrawable* sd = static_cast<osg::ShapeDrawable*>(_geode->getDrawable(index));
+    sd->setColor(osg::Vec4(co.redF(), co.greenF(), co.blueF(), co.alphaF()));
 }
 
 
@@ -121,6 +139,32 @@ void ActorSystem::fromVariantMap(QtEntity::EntityId eid, const QVariantMap& m, i
 }
 
 
+bool ActorSystem::applyPatch(QtEntity::EntityId eid, const QtEntity::PropertyPath& path, const QVariant& value, int context)
+{
+    Actor* a;
+    if(!component(eid, a)) return false;
+
+    // change a single shape instead of rebuilding all of them
+    if(path.field() == "shapes" && path.size() >= 2 && path.at(1).isIndex())
+    {
+        int index = path.at(1)._index;
+        if(index >= a->_shapes.size()) return false;
+
+        if(path.size() == 3 && path.at(2)._name == "Color")
+        {
+            a->setShapeColor(index, value.value<QColor>());
+            return true;
+        }
+
+        QtEntityUtils::Item shape = a->_shapes[index];
+        if(!QtEntityUtils::setValueAtPath(shape._value, path, 2, value)) return false;
+        a->setShape(index, shape);
+        return true;
+    }
+    return BaseClass::applyPatch(eid, path, value, context);
+}
+
+
 QVariantMap ActorSystem::editingAttributes(int) const
 {
 
@@ -26,7 +26,8 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags flags)
 
     QtEntityUtils::EntityEditor* editor = new QtEntityUtils::EntityEditor();
     connect(this, &MainWindow::selectedEntityChanged, editor, &QtEntityUtils::EntityEditor::displayEntity);
-    connect(editor, &QtEntityUtils::EntityEditor::entityDataChanged, this, &MainWindow::changeEntityData);
+    connect(editor, &QtEntityUtils::EntityEditor::entityFieldChanged, this, &MainWindow::changeEntityField);
+    editor->setFieldPatchesEnabled(true);
     centralWidget()->layout()->addWidget(editor);
 
     adjustSize();
@@ -129,6 +130,12 @@ void MainWindow::changeEntityData(QtEntity::EntityId id, const QVariantMap& valu
 }
 
 
+void MainWindow::changeEntityField(QtEntity::EntityId id, const QString& componentName, const QString& path, const QVariant& value)
+{
+    QtEntityUtils::EntityEditor::applyEntityPatch(_game->entityManager(), id, componentName, path, value);
+}
+
+
 // update entry in entity list
 void MainWindow::entityChanged(QtEntity::EntityId id, QString name)
 {
@@ -17,11 +17,66 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <QtEntity/EntityManager>
 
 #include <QtEntity/EntitySystem>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QDataStream>
 #include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <memory>
+#include <vector>
 
 namespace QtEntity
 {
 
+    namespace
+    {
+        const quint32 SAVEFILE_MAGIC = 0x51455357;
+        const quint32 SAVEFILE_VERSION = 1;
+
+        typedef std::vector<std::pair<QString, std::unique_ptr<SystemSnapshot> > > SnapshotList;
+
+
+        bool writeSnapshots(const QString& path, const SnapshotList& snapshots)
+        {
+            QSaveFile file(path);
+            if(!file.open(QIODevice::WriteOnly))
+            {
+                qWarning() << "Could not open save file" << path;
+                return false;
+            }
+
+            QDataStream stream(&file);
+            stream.setVersion(QDataStream::Qt_5_0);
+            stream << SAVEFILE_MAGIC << SAVEFILE_VERSION << quint32(snapshots.size());
+            for(auto i = snapshots.begin(); i != snapshots.end(); ++i)
+            {
+                stream << i->first;
+                i->second->write(stream);
+            }
+
+            if(stream.status() != QDataStream::Ok)
+            {
+                file.cancelWriting();
+                return false;
+            }
+            return file.commit();
+        }
+
+
+        std::shared_ptr<SnapshotList> createSnapshots(const EntityManager::EntitySystemStore& systems)
+        {
+            std::shared_ptr<SnapshotList> snapshots = std::make_shared<SnapshotList>();
+            snapshots->reserve(systems.size());
+            for(auto i = systems.begin(); i != systems.end(); ++i)
+            {
+                std::unique_ptr<SystemSnapshot> snapshot(i->second->createSnapshot(EntitySystem::STORAGE));
+                snapshots->push_back(std::make_pair(i->second->componentName(), std::move(snapshot)));
+            }
+            return snapshots;
+        }
+    }
+
+
 	EntityManager::EntityManager(QObject* parent)
 		: QObject(parent)
         , _entityCounter(1)
@@ -43,6 +98,7 @@ namespace QtEntity
     
     void EntityManager::destroyEntity(EntityId id)
     {
+        QTENTITY_PROFILE_ZONE("EntityManager::destroyEntity");
         for(auto i = _systems.begin(); i != _systems.end(); ++i)
         {
             i->second->destroyComponent(id);
@@ -50,6 +106,17 @@ namespace QtEntity
     }
 
 
+    MemoryStats EntityManager::memoryStats() const
+    {
+        MemoryStats stats;
+        for(auto i = _systems.begin(); i != _systems.end(); ++i)
+        {
+            stats += i->second->memoryStats();
+        }
+        return stats;
+    }
+
+
     void EntityManager::addSystem(int mid, EntitySystem* es)
     {
         _systems[mid] = es;
@@ -121,6 +188,30 @@ namespace QtEntity
     }
 
 
+    void* EntityManager::createComponent(EntityId id, int cid, const PropertyBag& properties)
+    {
+        EntitySystem* s = this->system(cid);
+
+        if(s == nullptr) return nullptr;
+
+        if(s->component(id) != nullptr)
+        {
+            qDebug() << "Component already exists! ComponentType:" << s->componentName() << " EntityId " << id;
+            return nullptr;
+        }
+
+        try
+        {
+            return s->createComponentFromBag(id, properties);
+        }
+        catch(std::bad_alloc&)
+        {
+            qCritical() << "Could not create component, bad allocation!";
+            return nullptr;
+        }
+    }
+
+
     bool EntityManager::destroyComponent(EntityId id, int cid)
     {
         EntitySystem* s = this->system(cid);
@@ -128,4 +219,79 @@ namespace QtEntity
         return s->destroyComponent(id);
     }
 
+
+
+    bool EntityManager::save(const QString& path)
+    {
+        return writeSnapshots(path, *createSnapshots(_systems));
+    }
+
+
+    QFuture<bool> EntityManager::beginAsyncSave(const QString& path)
+    {
+        std::shared_ptr<SnapshotList> snapshots = createSnapshots(_systems);
+        return QtConcurrent::run([path, snapshots]() {
+            return writeSnapshots(path, *snapshots);
+        });
+    }
+
+
+    bool EntityManager::load(const QString& path)
+    {
+        QFile file(path);
+        if(!file.open(QIODevice::ReadOnly))
+        {
+            qWarning() << "Could not open save file" << path;
+            return false;
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint32 magic, version, numSystems;
+        stream >> magic >> version >> numSystems;
+        if(magic != SAVEFILE_MAGIC || version != SAVEFILE_VERSION)
+        {
+            qWarning() << "Not a valid save file:" << path;
+            return false;
+        }
+
+        EntityId maxId = 0;
+        for(quint32 i = 0; i < numSystems && stream.status() == QDataStream::Ok; ++i)
+        {
+            QString name;
+            quint32 numComponents;
+            stream >> name >> numComponents;
+            EntitySystem* es = system(name);
+            if(es == nullptr)
+            {
+                qWarning() << "Skipping components of unknown entity system" << name;
+            }
+
+            for(quint32 j = 0; j < numComponents && stream.status() == QDataStream::Ok; ++j)
+            {
+                quint32 eid;
+                QVariantMap values;
+                stream >> eid >> values;
+                if(es == nullptr) continue;
+                maxId = qMax(maxId, EntityId(eid));
+                // values are in STORAGE format, create empty components
+                // and apply them in the matching context
+                if(es->component(eid) == nullptr &&
+                   createComponent(eid, es->componentType()) == nullptr)
+                {
+                    continue;
+                }
+                es->fromVariantMap(eid, values, EntitySystem::STORAGE);
+            }
+        }
+
+        // make sure new entity ids do not collide with loaded ones
+        int counter = _entityCounter.load();
+        while(counter <= int(maxId) && !_entityCounter.testAndSetOrdered(counter, int(maxId) + 1))
+        {
+            counter = _entityCounter.load();
+        }
+
+        return stream.status() == QDataStream::Ok;
+    }
 }
@@ -17,11 +17,32 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <QtEntity/EntitySystem>
 
 #include <QtEntity/EntityManager>
+#include <QDebug>
 #include <unordered_map>
 
 namespace QtEntity
 {
 
+    namespace
+    {
+        // Snapshot holding the variant maps of all components
+        class VariantMapSnapshot : public SystemSnapshot
+        {
+        public:
+            virtual void write(QDataStream& stream) const override
+            {
+                stream << quint32(_components.size());
+                for(auto i = _components.begin(); i != _components.end(); ++i)
+                {
+                    stream << quint32(i->first) << i->second;
+                }
+            }
+
+            QVector<QPair<EntityId, QVariantMap> > _components;
+        };
+    }
+
+
     EntitySystem::EntitySystem(int metatypeid, EntityManager* em)
         : QObject(em)
         , _entityManager(em)
@@ -39,6 +60,75 @@ namespace QtEntity
     }
 
 
+    void* EntitySystem::createComponentFromBag(EntityId id, const PropertyBag& properties)
+    {
+        QTENTITY_PROFILE_ZONE("EntitySystem::createComponentFromBag");
+        if(propertyTable() == nullptr)
+        {
+            return createComponent(id, properties.toVariantMap());
+        }
+        void* c = createComponent(id);
+        if(c != nullptr && !properties.isEmpty())
+        {
+            fromPropertyBag(id, properties);
+        }
+        return c;
+    }
+
+
+    void EntitySystem::fromPropertyBag(EntityId eid, const PropertyBag& properties, int conversionContext)
+    {
+        QTENTITY_PROFILE_ZONE("EntitySystem::fromPropertyBag");
+        fromVariantMap(eid, properties.toVariantMap(), conversionContext);
+    }
+
+
+    void EntitySystem::fromPropertyBagForAll(const QList<EntityId>& eids, const PropertyBag& properties, int conversionContext)
+    {
+        QTENTITY_PROFILE_ZONE("EntitySystem::fromPropertyBagForAll");
+        QVariantMap m = properties.toVariantMap();
+        for(EntityId eid : eids)
+        {
+            if(component(eid) != nullptr)
+            {
+                fromVariantMap(eid, m, conversionContext);
+            }
+        }
+    }
+
+
+    bool EntitySystem::applyPatch(EntityId eid, const PropertyPath& path, const QVariant& value, int conversionContext)
+    {
+        if(path.size() != 1 || component(eid) == nullptr)
+        {
+            return false;
+        }
+        QVariantMap m;
+        m.insert(path.field(), value);
+        fromVariantMap(eid, m, conversionContext);
+        return true;
+    }
+
+
+    SystemSnapshot* EntitySystem::createSnapshot(int conversionContext)
+    {
+        VariantMapSnapshot* snapshot = new VariantMapSnapshot();
+        snapshot->_components.reserve(int(count()));
+        PIterator end = pend();
+        for(PIterator i = pbegin(); i != end; ++i)
+        {
+            EntityId id = i.id();
+            if(id == 0)
+            {
+                qWarning() << "Could not snapshot components of" << componentName() << ", iterator does not provide entity ids";
+                break;
+            }
+            snapshot->_components.push_back(qMakePair(id, toVariantMap(id, conversionContext)));
+        }
+        return snapshot;
+    }
+
+
     QString EntitySystem::componentName() const
     { 
         return QMetaType::typeName(componentType());
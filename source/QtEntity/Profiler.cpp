@@ -0,0 +1,341 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <QtEntity/Profiler>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <algorithm>
+
+namespace QtEntity
+{
+    namespace
+    {
+        // ring buffer of events recorded by a single thread
+        struct ThreadBuffer
+        {
+            QMutex _mutex;
+            QVector<ProfileEvent> _events;
+
+            // total number of events written, index of next event is _written % size
+            quint64 _written;
+
+            // events before this count were already included in a frame summary
+            quint64 _summarized;
+
+            // sequential thread number used in trace output
+            int _thread;
+        };
+
+
+        struct ProfilerData
+        {
+            ProfilerData()
+                : _enabled(1)
+                , _bufferSize(65536)
+                , _frameStart(0)
+                , _frameTime(0)
+            {
+                _timer.start();
+            }
+
+            ~ProfilerData()
+            {
+                qDeleteAll(_buffers);
+            }
+
+            QElapsedTimer _timer;
+            QAtomicInt _enabled;
+
+            // guards all following members
+            QMutex _mutex;
+            int _bufferSize;
+            QList<ThreadBuffer*> _buffers;
+            qint64 _frameStart;
+            qint64 _frameTime;
+            QVector<ProfileZoneStats> _frameSummary;
+
+            // names passed to internName, never removed
+            QHash<QString, QByteArray> _names;
+        };
+
+
+        ProfilerData& profilerData()
+        {
+            static ProfilerData data;
+            return data;
+        }
+
+
+        thread_local ThreadBuffer* t_buffer = nullptr;
+
+
+        // buffer of current thread, created on first use
+        ThreadBuffer* threadBuffer()
+        {
+            if(t_buffer == nullptr)
+            {
+                ProfilerData& d = profilerData();
+                QMutexLocker lock(&d._mutex);
+                ThreadBuffer* b = new ThreadBuffer();
+                b->_events.resize(d._bufferSize);
+                b->_written = 0;
+                b->_summarized = 0;
+                b->_thread = d._buffers.size() + 1;
+                d._buffers.push_back(b);
+                t_buffer = b;
+            }
+            return t_buffer;
+        }
+
+
+        // index of oldest event still in buffer
+        quint64 firstAvailable(const ThreadBuffer* b)
+        {
+            quint64 size = b->_events.size();
+            return (b->_written > size) ? b->_written - size : 0;
+        }
+
+
+        void appendEscaped(QByteArray& out, const char* str)
+        {
+            for(const char* c = str; *c != 0; ++c)
+            {
+                if(*c == '"' || *c == '\\') out.append('\\');
+                out.append(*c);
+            }
+        }
+
+
+        void appendMicroseconds(QByteArray& out, qint64 ns)
+        {
+            out.append(QByteArray::number(double(ns) / 1000.0, 'f', 3));
+        }
+    }
+
+
+    void Profiler::setEnabled(bool enabled)
+    {
+        profilerData()._enabled.store(enabled ? 1 : 0);
+    }
+
+
+    bool Profiler::isEnabled()
+    {
+        return profilerData()._enabled.load() != 0;
+    }
+
+
+    void Profiler::setBufferSize(int events)
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+        d._bufferSize = qMax(16, events);
+    }
+
+
+    qint64 Profiler::now()
+    {
+        return profilerData()._timer.nsecsElapsed();
+    }
+
+
+    void Profiler::record(const char* name, qint64 start, qint64 end)
+    {
+        if(profilerData()._enabled.load() == 0) return;
+
+        ThreadBuffer* b = threadBuffer();
+        QMutexLocker lock(&b->_mutex);
+        ProfileEvent& e = b->_events[b->_written % b->_events.size()];
+        e._name = name;
+        e._start = start;
+        e._end = end;
+        ++b->_written;
+    }
+
+
+    const char* Profiler::internName(const QString& name)
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+        auto i = d._names.find(name);
+        if(i == d._names.end())
+        {
+            i = d._names.insert(name, name.toUtf8());
+        }
+        return i->constData();
+    }
+
+
+    void Profiler::beginFrame()
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+        d._frameStart = now();
+
+        // events of previous frames are not part of the summary
+        foreach(ThreadBuffer* b, d._buffers)
+        {
+            QMutexLocker block(&b->_mutex);
+            b->_summarized = b->_written;
+        }
+    }
+
+
+    void Profiler::endFrame()
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+        qint64 frameEnd = now();
+
+        // only look at events written since last summary.
+        // Zones are counted by name pointer, merged by name afterwards
+        QHash<const char*, ProfileZoneStats> zones;
+        foreach(ThreadBuffer* b, d._buffers)
+        {
+            QMutexLocker block(&b->_mutex);
+            quint64 size = b->_events.size();
+            for(quint64 i = qMax(b->_summarized, firstAvailable(b)); i < b->_written; ++i)
+            {
+                const ProfileEvent& e = b->_events[i % size];
+                if(e._start < d._frameStart) continue;
+                auto z = zones.find(e._name);
+                if(z == zones.end())
+                {
+                    ProfileZoneStats s;
+                    s._count = 0;
+                    s._totalNs = 0;
+                    s._maxNs = 0;
+                    z = zones.insert(e._name, s);
+                }
+                qint64 duration = e._end - e._start;
+                ++z->_count;
+                z->_totalNs += duration;
+                z->_maxNs = qMax(z->_maxNs, duration);
+            }
+            b->_summarized = b->_written;
+        }
+
+        QHash<QString, ProfileZoneStats> stats;
+        for(auto z = zones.begin(); z != zones.end(); ++z)
+        {
+            QString name = QString::fromLatin1(z.key());
+            auto s = stats.find(name);
+            if(s == stats.end())
+            {
+                stats.insert(name, z.value())->_name = name;
+            }
+            else
+            {
+                s->_count += z->_count;
+                s->_totalNs += z->_totalNs;
+                s->_maxNs = qMax(s->_maxNs, z->_maxNs);
+            }
+        }
+
+        d._frameSummary = stats.values().toVector();
+        std::sort(d._frameSummary.begin(), d._frameSummary.end(), [](const ProfileZoneStats& a, const ProfileZoneStats& b) {
+            return a._totalNs > b._totalNs;
+        });
+        d._frameTime = frameEnd - d._frameStart;
+    }
+
+
+    QVector<ProfileZoneStats> Profiler::frameSummary()
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+        return d._frameSummary;
+    }
+
+
+    qint64 Profiler::frameTime()
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+        return d._frameTime;
+    }
+
+
+    QByteArray Profiler::chromeTrace()
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+
+        QByteArray out;
+        out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        bool first = true;
+        foreach(ThreadBuffer* b, d._buffers)
+        {
+            QMutexLocker block(&b->_mutex);
+
+            // name thread in trace viewer
+            if(!first) out.append(",\n");
+            first = false;
+            out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+            out.append(QByteArray::number(b->_thread));
+            out.append(",\"args\":{\"name\":\"Thread ");
+            out.append(QByteArray::number(b->_thread));
+            out.append("\"}}");
+
+            quint64 size = b->_events.size();
+            for(quint64 i = firstAvailable(b); i < b->_written; ++i)
+            {
+                const ProfileEvent& e = b->_events[i % size];
+                out.append(",\n{\"name\":\"");
+                appendEscaped(out, e._name);
+                out.append("\",\"cat\":\"qtentity\",\"ph\":\"X\",\"ts\":");
+                appendMicroseconds(out, e._start);
+                out.append(",\"dur\":");
+                appendMicroseconds(out, e._end - e._start);
+                out.append(",\"pid\":1,\"tid\":");
+                out.append(QByteArray::number(b->_thread));
+                out.append("}");
+            }
+        }
+        out.append("]}\n");
+        return out;
+    }
+
+
+    bool Profiler::writeChromeTrace(const QString& path)
+    {
+        QFile file(path);
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        return file.write(chromeTrace()) != -1;
+    }
+
+
+    void Profiler::clear()
+    {
+        ProfilerData& d = profilerData();
+        QMutexLocker lock(&d._mutex);
+        foreach(ThreadBuffer* b, d._buffers)
+        {
+            QMutexLocker block(&b->_mutex);
+            b->_written = 0;
+            b->_summarized = 0;
+        }
+        d._frameSummary.clear();
+        d._frameTime = 0;
+    }
+}
@@ -0,0 +1,148 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntity/PropertyBag>
+
+#include <QHash>
+#include <QReadWriteLock>
+
+namespace QtEntity
+{
+
+    namespace
+    {
+        struct FieldRegistry
+        {
+            QReadWriteLock _lock;
+            QHash<QString, FieldId> _ids;
+            QVector<QString> _names;
+        };
+
+        FieldRegistry& registry()
+        {
+            static FieldRegistry r;
+            return r;
+        }
+    }
+
+
+    const FieldId FieldNames::INVALID;
+
+
+    FieldId FieldNames::intern(const QString& name)
+    {
+        FieldRegistry& r = registry();
+        {
+            QReadLocker l(&r._lock);
+            auto i = r._ids.find(name);
+            if(i != r._ids.end()) return i.value();
+        }
+        QWriteLocker l(&r._lock);
+        // may have been added between releasing read lock and acquiring write lock
+        auto i = r._ids.find(name);
+        if(i != r._ids.end()) return i.value();
+        FieldId id = r._names.size();
+        r._names.push_back(name);
+        r._ids[name] = id;
+        return id;
+    }
+
+
+    FieldId FieldNames::find(const QString& name)
+    {
+        FieldRegistry& r = registry();
+        QReadLocker l(&r._lock);
+        return r._ids.value(name, INVALID);
+    }
+
+
+    QString FieldNames::name(FieldId field)
+    {
+        FieldRegistry& r = registry();
+        QReadLocker l(&r._lock);
+        if(field >= (FieldId)r._names.size()) return QString();
+        return r._names[field];
+    }
+
+
+    FieldId FieldNames::count()
+    {
+        FieldRegistry& r = registry();
+        QReadLocker l(&r._lock);
+        return r._names.size();
+    }
+
+
+    PropertyBag::PropertyBag(const QVariantMap& m)
+    {
+        _entries.reserve(m.size());
+        for(auto i = m.begin(); i != m.end(); ++i)
+        {
+            Entry e;
+            e._field = FieldNames::intern(i.key());
+            e._value = i.value();
+            _entries.push_back(e);
+        }
+    }
+
+
+    void PropertyBag::insert(FieldId field, const QVariant& value)
+    {
+        for(auto i = _entries.begin(); i != _entries.end(); ++i)
+        {
+            if(i->_field == field)
+            {
+                i->_value = value;
+                return;
+            }
+        }
+        Entry e;
+        e._field = field;
+        e._value = value;
+        _entries.push_back(e);
+    }
+
+
+    QVariant PropertyBag::value(FieldId field, const QVariant& defaultValue) const
+    {
+        for(auto i = _entries.begin(); i != _entries.end(); ++i)
+        {
+            if(i->_field == field) return i->_value;
+        }
+        return defaultValue;
+    }
+
+
+    bool PropertyBag::contains(FieldId field) const
+    {
+        for(auto i = _entries.begin(); i != _entries.end(); ++i)
+        {
+            if(i->_field == field) return true;
+        }
+        return false;
+    }
+
+
+    QVariantMap PropertyBag::toVariantMap() const
+    {
+        QVariantMap m;
+        for(auto i = _entries.begin(); i != _entries.end(); ++i)
+        {
+            m.insert(FieldNames::name(i->_field), i->_value);
+        }
+        return m;
+    }
+}
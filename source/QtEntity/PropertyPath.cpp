@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntity/PropertyPath>
+
+namespace QtEntity
+{
+
+    PropertyPath::PropertyPath(const QString& path)
+    {
+        int pos = 0;
+        while(pos < path.size())
+        {
+            if(path[pos] == '[')
+            {
+                int close = path.indexOf(']', pos);
+                bool ok = false;
+                int index = (close == -1) ? -1 : path.mid(pos + 1, close - pos - 1).toInt(&ok);
+                if(!ok || index < 0 || _segments.isEmpty())
+                {
+                    _segments.clear();
+                    return;
+                }
+                appendIndex(index);
+                pos = close + 1;
+            }
+            else
+            {
+                if(path[pos] == '.')
+                {
+                    if(_segments.isEmpty())
+                    {
+                        return;
+                    }
+                    ++pos;
+                }
+                int end = pos;
+                while(end < path.size() && path[end] != '.' && path[end] != '[') ++end;
+                if(end == pos)
+                {
+                    _segments.clear();
+                    return;
+                }
+                appendName(path.mid(pos, end - pos));
+                pos = end;
+            }
+        }
+    }
+
+
+    PropertyPath& PropertyPath::appendName(const QString& name)
+    {
+        Segment s;
+        s._name = name;
+        _segments.push_back(s);
+        return *this;
+    }
+
+
+    PropertyPath& PropertyPath::appendIndex(int index)
+    {
+        Segment s;
+        s._index = index;
+        _segments.push_back(s);
+        return *this;
+    }
+
+
+    QString PropertyPath::toString() const
+    {
+        QString ret;
+        for(auto i = _segments.begin(); i != _segments.end(); ++i)
+        {
+            if(i->isIndex())
+            {
+                ret += QString("[%1]").arg(i->_index);
+            }
+            else
+            {
+                if(!ret.isEmpty()) ret += '.';
+                ret += i->_name;
+            }
+        }
+        return ret;
+    }
+}
@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntity/PropertyTable>
+
+#include <QtEntity/EntitySystem>
+#include <algorithm>
+
+namespace QtEntity
+{
+
+    PropertyTable::PropertyTable(const QMetaObject* meta)
+        : _metaObject(meta)
+    {
+        for(int i = 0; i < meta->propertyCount(); ++i)
+        {
+            QMetaProperty prop = meta->property(i);
+            if(!prop.isReadable()) continue;
+            Entry e;
+            e._name = QString::fromLatin1(prop.name());
+            e._field = FieldNames::intern(e._name);
+            e._property = prop;
+            _indices[e._name] = _entries.size();
+            if(e._field >= (FieldId)_fieldIndices.size())
+            {
+                int oldSize = _fieldIndices.size();
+                _fieldIndices.resize(e._field + 1);
+                std::fill(_fieldIndices.begin() + oldSize, _fieldIndices.end(), -1);
+            }
+            _fieldIndices[e._field] = _entries.size();
+            _entries.push_back(e);
+        }
+    }
+
+
+    QVariant PropertyTable::read(int index, const void* gadget) const
+    {
+        return _entries[index]._property.readOnGadget(gadget);
+    }
+
+
+    bool PropertyTable::write(int index, void* gadget, const QVariant& value) const
+    {
+        return _entries[index]._property.writeOnGadget(gadget, value);
+    }
+
+
+    QVariantMap PropertyTable::toVariantMap(const void* gadget, int conversionContext) const
+    {
+        QVariantMap m;
+        for(auto i = _entries.begin(); i != _entries.end(); ++i)
+        {
+            if(conversionContext == EntitySystem::STORAGE && !i->_property.isStored()) continue;
+            if(conversionContext == EntitySystem::EDIT_SIMPLE && !i->_property.isDesignable()) continue;
+            m.insert(i->_name, i->_property.readOnGadget(gadget));
+        }
+        return m;
+    }
+
+
+    void PropertyTable::fromVariantMap(void* gadget, const QVariantMap& m) const
+    {
+        for(auto i = m.begin(); i != m.end(); ++i)
+        {
+            auto j = _indices.find(i.key());
+            if(j == _indices.end()) continue;
+            _entries[j.value()]._property.writeOnGadget(gadget, i.value());
+        }
+    }
+
+
+    void PropertyTable::fromPropertyBag(void* gadget, const PropertyBag& bag) const
+    {
+        for(auto i = bag.begin(); i != bag.end(); ++i)
+        {
+            int index = indexOfField(i->_field);
+            if(index == -1) continue;
+            _entries[index]._property.writeOnGadget(gadget, i->_value);
+        }
+    }
+
+
+    QVector<QPair<int, QVariant> > PropertyTable::resolve(const PropertyBag& bag) const
+    {
+        QVector<QPair<int, QVariant> > resolved;
+        resolved.reserve(bag.size());
+        for(auto i = bag.begin(); i != bag.end(); ++i)
+        {
+            int index = indexOfField(i->_field);
+            if(index == -1) continue;
+            QVariant value = i->_value;
+            int type = _entries[index]._property.userType();
+            if(value.userType() != type && value.canConvert(type))
+            {
+                value.convert(type);
+            }
+            resolved.push_back(qMakePair(index, value));
+        }
+        return resolved;
+    }
+}
@@ -0,0 +1,144 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntityScript/ComponentScriptClass>
+
+#include <QtEntity/EntitySystem>
+#include <QtEntity/PropertyTable>
+#include <QScriptEngine>
+
+namespace QtEntityScript
+{
+
+    ComponentScriptClass::ComponentScriptClass(QScriptEngine* engine, QtEntity::EntitySystem* es)
+        : QScriptClass(engine)
+        , _system(es)
+        , _table(es->propertyTable())
+    {
+        if(_table != nullptr)
+        {
+            for(int i = 0; i < _table->count(); ++i)
+            {
+                _indices.insert(engine->toStringHandle(_table->name(i)), uint(i));
+            }
+        }
+    }
+
+
+    QScriptValue ComponentScriptClass::newProxy(QtEntity::EntityId id)
+    {
+        return engine()->newObject(this, QScriptValue(uint(id)));
+    }
+
+
+    QScriptClass::QueryFlags ComponentScriptClass::queryProperty(const QScriptValue& object,
+                                                                 const QScriptString& name,
+                                                                 QueryFlags flags, uint* id)
+    {
+        Q_UNUSED(flags)
+        auto i = _indices.find(name);
+        if(i != _indices.end())
+        {
+            *id = i.value();
+            return HandlesReadAccess | HandlesWriteAccess;
+        }
+
+        if(_table != nullptr)
+        {
+            return 0;
+        }
+
+        // Systems without property table: Learn property names
+        // from the variant map of the component
+        QtEntity::EntityId eid = object.data().toUInt32();
+        QVariantMap m = _system->toVariantMap(eid);
+        for(auto j = m.begin(); j != m.end(); ++j)
+        {
+            QScriptString key = engine()->toStringHandle(j.key());
+            if(!_indices.contains(key))
+            {
+                _indices.insert(key, uint(_fallbackNames.size()));
+                _fallbackNames.push_back(j.key());
+            }
+        }
+
+        i = _indices.find(name);
+        if(i == _indices.end())
+        {
+            return 0;
+        }
+        *id = i.value();
+        return HandlesReadAccess | HandlesWriteAccess;
+    }
+
+
+    QScriptValue ComponentScriptClass::property(const QScriptValue& object, const QScriptString& name, uint id)
+    {
+        Q_UNUSED(name)
+        QtEntity::EntityId eid = object.data().toUInt32();
+        void* component = _system->component(eid);
+        if(component == nullptr)
+        {
+            return QScriptValue(QScriptValue::UndefinedValue);
+        }
+
+        if(_table != nullptr)
+        {
+            return engine()->toScriptValue(_table->read(int(id), component));
+        }
+        return engine()->toScriptValue(_system->toVariantMap(eid).value(_fallbackNames[int(id)]));
+    }
+
+
+    void ComponentScriptClass::setProperty(QScriptValue& object, const QScriptString& name,
+                                           uint id, const QScriptValue& value)
+    {
+        Q_UNUSED(name)
+        QtEntity::EntityId eid = object.data().toUInt32();
+        void* component = _system->component(eid);
+        if(component == nullptr)
+        {
+            return;
+        }
+
+        if(_table != nullptr)
+        {
+            _table->write(int(id), component, value.toVariant());
+        }
+        else
+        {
+            QVariantMap m;
+            m.insert(_fallbackNames[int(id)], value.toVariant());
+            _system->fromVariantMap(eid, m);
+        }
+    }
+
+
+    QScriptValue::PropertyFlags ComponentScriptClass::propertyFlags(const QScriptValue& object,
+                                                                    const QScriptString& name, uint id)
+    {
+        Q_UNUSED(object)
+        Q_UNUSED(name)
+        Q_UNUSED(id)
+        return QScriptValue::Undeletable;
+    }
+
+
+    QString ComponentScriptClass::name() const
+    {
+        return _system->componentName();
+    }
+}
@@ -0,0 +1,202 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntityScript/JSBindings>
+
+#include <QtEntity/EntityManager>
+#include <QtEntity/EntitySystem>
+#include <QtEntity/PropertyTable>
+#include <QDebug>
+#include <QJSEngine>
+
+namespace QtEntityScript
+{
+
+    namespace
+    {
+        // Wraps a JSEntitySystem in an object with the API of the QtScript bindings.
+        // Field accessors of component proxies are defined once on a shared prototype.
+        const char* SYSTEM_WRAPPER =
+            "(function(sys) {\n"
+            "    var proto = null;\n"
+            "    function createPrototype(id) {\n"
+            "        var p = {};\n"
+            "        sys.fieldNames(id).forEach(function(name, index) {\n"
+            "            Object.defineProperty(p, name, {\n"
+            "                get: function() { return sys.readField(this.__id, index); },\n"
+            "                set: function(v) { sys.writeField(this.__id, index, v); }\n"
+            "            });\n"
+            "        });\n"
+            "        return p;\n"
+            "    }\n"
+            "    return {\n"
+            "        createComponent: function(id, params) { return sys.createComponent(id, params || {}); },\n"
+            "        destroyComponent: function(id) { return sys.destroyComponent(id); },\n"
+            "        count: function() { return sys.count(); },\n"
+            "        toVariantMap: function(id) { return sys.toVariantMap(id); },\n"
+            "        fromVariantMap: function(id, m) { sys.fromVariantMap(id, m); },\n"
+            "        get: function(id) {\n"
+            "            if(!sys.hasComponent(id)) return null;\n"
+            "            if(proto === null) proto = createPrototype(id);\n"
+            "            return Object.create(proto, { __id: { value: id } });\n"
+            "        }\n"
+            "    };\n"
+            "})";
+
+        // Wraps the entity manager, entity systems are added as properties
+        const char* MANAGER_WRAPPER =
+            "(function(em) {\n"
+            "    return {\n"
+            "        createEntityId: function() { return em.createEntityId(); },\n"
+            "        destroyEntity: function(id) { em.destroyEntity(id); }\n"
+            "    };\n"
+            "})";
+    }
+
+
+    JSEntityManager::JSEntityManager(QtEntity::EntityManager* em, QObject* parent)
+        : QObject(parent)
+        , _entityManager(em)
+    {
+    }
+
+
+    quint32 JSEntityManager::createEntityId()
+    {
+        return _entityManager->createEntityId();
+    }
+
+
+    void JSEntityManager::destroyEntity(quint32 id)
+    {
+        _entityManager->destroyEntity(id);
+    }
+
+
+    JSEntitySystem::JSEntitySystem(QtEntity::EntitySystem* es, QObject* parent)
+        : QObject(parent)
+        , _system(es)
+        , _table(es->propertyTable())
+    {
+    }
+
+
+    bool JSEntitySystem::createComponent(quint32 id, const QVariantMap& params)
+    {
+        return _system->createComponent(id, params) != nullptr;
+    }
+
+
+    bool JSEntitySystem::destroyComponent(quint32 id)
+    {
+        return _system->destroyComponent(id);
+    }
+
+
+    bool JSEntitySystem::hasComponent(quint32 id) const
+    {
+        return _system->component(id) != nullptr;
+    }
+
+
+    quint32 JSEntitySystem::count() const
+    {
+        return quint32(_system->count());
+    }
+
+
+    QVariantMap JSEntitySystem::toVariantMap(quint32 id)
+    {
+        return _system->toVariantMap(id);
+    }
+
+
+    void JSEntitySystem::fromVariantMap(quint32 id, const QVariantMap& m)
+    {
+        _system->fromVariantMap(id, m);
+    }
+
+
+    QStringList JSEntitySystem::fieldNames(quint32 id)
+    {
+        if(_fieldNames.isEmpty())
+        {
+            if(_table != nullptr)
+            {
+                for(int i = 0; i < _table->count(); ++i)
+                {
+                    _fieldNames.push_back(_table->name(i));
+                }
+            }
+            else
+            {
+                _fieldNames = _system->toVariantMap(id).keys();
+            }
+        }
+        return _fieldNames;
+    }
+
+
+    QVariant JSEntitySystem::readField(quint32 id, int index)
+    {
+        if(_table != nullptr)
+        {
+            void* component = _system->component(id);
+            return (component == nullptr) ? QVariant() : _table->read(index, component);
+        }
+        return _system->toVariantMap(id).value(_fieldNames.value(index));
+    }
+
+
+    void JSEntitySystem::writeField(quint32 id, int index, const QVariant& value)
+    {
+        if(_table != nullptr)
+        {
+            void* component = _system->component(id);
+            if(component != nullptr)
+            {
+                _table->write(index, component, value);
+            }
+            return;
+        }
+        QVariantMap m;
+        m.insert(_fieldNames.value(index), value);
+        _system->fromVariantMap(id, m);
+    }
+
+
+    void exposeEntityManager(QJSEngine* engine, QtEntity::EntityManager* em, const QString& name)
+    {
+        QJSValue wrapManager = engine->evaluate(MANAGER_WRAPPER);
+        QJSValue wrapSystem = engine->evaluate(SYSTEM_WRAPPER);
+        if(wrapManager.isError() || wrapSystem.isError())
+        {
+            qWarning() << "Could not create entity manager wrapper:" << wrapManager.toString() << wrapSystem.toString();
+            return;
+        }
+
+        // wrapped objects are owned by engine, so they are not garbage collected
+        JSEntityManager* jsem = new JSEntityManager(em, engine);
+        QJSValue emValue = wrapManager.call(QJSValueList() << engine->newQObject(jsem));
+        for(auto i = em->begin(); i != em->end(); ++i)
+        {
+            JSEntitySystem* es = new JSEntitySystem(i->second, engine);
+            QJSValue wrapped = wrapSystem.call(QJSValueList() << engine->newQObject(es));
+            emValue.setProperty(i->second->componentName(), wrapped);
+        }
+        engine->globalObject().setProperty(name, emValue);
+    }
+}
@@ -0,0 +1,112 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntityScript/ScriptBindings>
+
+#include <QtEntityScript/ComponentScriptClass>
+#include <QtEntity/EntityManager>
+#include <QScriptEngine>
+
+namespace QtEntityScript
+{
+
+    namespace
+    {
+        QScriptValue entityIdToScriptValue(QScriptEngine* engine, const QtEntity::EntityId& s)
+        {
+            Q_UNUSED(engine)
+            return QScriptValue(uint(s));
+        }
+
+
+        void entityIdFromScriptValue(const QScriptValue& obj, QtEntity::EntityId& s)
+        {
+            s = obj.toUInt32();
+        }
+    }
+
+
+    EntitySystemPrototype::EntitySystemPrototype(QObject* parent)
+        : QObject(parent)
+    {
+    }
+
+
+    EntitySystemPrototype::~EntitySystemPrototype()
+    {
+        qDeleteAll(_componentClasses);
+    }
+
+
+    QtEntity::EntitySystem* EntitySystemPrototype::thisSystem() const
+    {
+        return qscriptvalue_cast<QtEntity::EntitySystem*>(thisObject());
+    }
+
+
+    bool EntitySystemPrototype::createComponent(QtEntity::EntityId id, const QVariantMap& params)
+    {
+        return (thisSystem()->createComponent(id, params) != nullptr);
+    }
+
+
+    bool EntitySystemPrototype::destroyComponent(QtEntity::EntityId id)
+    {
+        return thisSystem()->destroyComponent(id);
+    }
+
+
+    quint32 EntitySystemPrototype::count() const
+    {
+        return (quint32)thisSystem()->count();
+    }
+
+
+    QScriptValue EntitySystemPrototype::get(QtEntity::EntityId id)
+    {
+        QtEntity::EntitySystem* es = thisSystem();
+        if(es == nullptr || es->component(id) == nullptr)
+        {
+            return QScriptValue(QScriptValue::NullValue);
+        }
+        return componentClass(es)->newProxy(id);
+    }
+
+
+    ComponentScriptClass* EntitySystemPrototype::componentClass(QtEntity::EntitySystem* es)
+    {
+        auto i = _componentClasses.find(es);
+        if(i != _componentClasses.end())
+        {
+            return i.value();
+        }
+        ComponentScriptClass* c = new ComponentScriptClass(engine(), es);
+        _componentClasses.insert(es, c);
+        return c;
+    }
+
+
+    void exposeEntityManager(QScriptEngine* engine, QtEntity::EntityManager* em, const QString& name)
+    {
+        qRegisterMetaType<QtEntity::EntityId>("QtEntity::EntityId");
+        qScriptRegisterMetaType(engine, entityIdToScriptValue, entityIdFromScriptValue);
+
+        EntitySystemPrototype* esProto = new EntitySystemPrototype(engine);
+        engine->setDefaultPrototype(qMetaTypeId<QtEntity::EntitySystem*>(), engine->newQObject(esProto));
+
+        engine->globalObject().setProperty(name, engine->newQObject(em));
+    }
+}
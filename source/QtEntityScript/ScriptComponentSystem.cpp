@@ -0,0 +1,225 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntityScript/ScriptComponentSystem>
+
+#include <QtEntityScript/ScriptProfiler>
+#include <QDebug>
+#include <QFile>
+#include <QScriptEngine>
+#include <QTextStream>
+
+namespace QtEntityScript
+{
+
+    namespace
+    {
+        bool readSource(const QString& path, QString& sourceCode)
+        {
+            QFile file(path);
+            if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            {
+                qWarning() << "Could not open script file" << path;
+                return false;
+            }
+            QTextStream stream(&file);
+            stream.setCodec("UTF-8");
+            sourceCode = stream.readAll();
+            return true;
+        }
+    }
+
+
+    ScriptComponentSystem::ScriptComponentSystem(QtEntity::EntityManager* em, QScriptEngine* engine)
+        : BaseClass(em)
+        , _engine(engine)
+        , _watcher(nullptr)
+        , _profiler(nullptr)
+    {
+    }
+
+
+    ScriptComponentSystem::~ScriptComponentSystem()
+    {
+    }
+
+
+    QVariantMap ScriptComponentSystem::toVariantMap(QtEntity::EntityId eid, int context)
+    {
+        Q_UNUSED(context)
+        QVariantMap m;
+        ScriptComponent* c;
+        if(component(eid, c))
+        {
+            m["path"] = c->_path;
+        }
+        return m;
+    }
+
+
+    void ScriptComponentSystem::fromVariantMap(QtEntity::EntityId eid, const QVariantMap& m, int context)
+    {
+        Q_UNUSED(context)
+        ScriptComponent* c;
+        if(!component(eid, c) || !m.contains("path")) return;
+
+        QString path = m["path"].toString();
+        if(path == c->_path) return;
+        c->_path = path;
+        c->_script = path.isEmpty() ? QSharedPointer<ScriptComponentScript>() : findOrLoadScript(path);
+    }
+
+
+    void ScriptComponentSystem::tick(double dt)
+    {
+        if(_profiler != nullptr) _profiler->beginZone(componentName() + "::tick");
+        QScriptValue delta(dt);
+        for(auto i = begin(); i != end(); ++i)
+        {
+            ScriptComponentScript* script = i->second->_script.data();
+            if(script == nullptr || !script->_update.isFunction()) continue;
+
+            script->_update.call(script->_behaviour, QScriptValueList() << QScriptValue(uint(i->first)) << delta);
+            if(_engine->hasUncaughtException())
+            {
+                qWarning() << "Error in script" << script->_path << ":" << _engine->uncaughtException().toString();
+                _engine->clearExceptions();
+            }
+        }
+        if(_profiler != nullptr) _profiler->endZone();
+    }
+
+
+    QSharedPointer<ScriptComponentScript> ScriptComponentSystem::findOrLoadScript(const QString& path)
+    {
+        auto i = _scripts.find(path);
+        if(i != _scripts.end())
+        {
+            return i.value();
+        }
+
+        QSharedPointer<ScriptComponentScript> script(new ScriptComponentScript());
+        script->_path = path;
+        _scripts.insert(path, script);
+
+        QString sourceCode;
+        if(readSource(path, sourceCode))
+        {
+            updateScript(*script, sourceCode);
+        }
+        if(_watcher != nullptr)
+        {
+            _watcher->addPath(path);
+        }
+        return script;
+    }
+
+
+    bool ScriptComponentSystem::updateScript(ScriptComponentScript& script, const QString& sourceCode)
+    {
+        QByteArray hash = ScriptProgramCache::hash(sourceCode);
+        if(hash == script._hash)
+        {
+            return false;
+        }
+
+        QByteArray oldHash = script._hash;
+        script._hash = hash;
+        script._program = _programCache.program(sourceCode, script._path);
+        script._behaviour = _engine->evaluate(script._program);
+        if(_engine->hasUncaughtException())
+        {
+            qWarning() << "Error in script" << script._path << ":" << _engine->uncaughtException().toString();
+            _engine->clearExceptions();
+            script._behaviour = QScriptValue();
+        }
+        script._update = script._behaviour.property("update");
+
+        // drop old program if no other script uses it
+        if(!oldHash.isEmpty())
+        {
+            bool used = false;
+            for(auto i = _scripts.begin(); i != _scripts.end() && !used; ++i)
+            {
+                used = (i.value()->_hash == oldHash);
+            }
+            if(!used)
+            {
+                _programCache.remove(oldHash);
+            }
+        }
+        return true;
+    }
+
+
+    bool ScriptComponentSystem::reloadScript(const QString& path)
+    {
+        auto i = _scripts.find(path);
+        if(i == _scripts.end()) return false;
+
+        QString sourceCode;
+        if(!readSource(path, sourceCode) || !updateScript(*i.value(), sourceCode))
+        {
+            return false;
+        }
+        emit scriptReloaded(path);
+        return true;
+    }
+
+
+    int ScriptComponentSystem::reloadScripts()
+    {
+        int changed = 0;
+        QStringList paths = _scripts.keys();
+        foreach(const QString& path, paths)
+        {
+            if(reloadScript(path)) ++changed;
+        }
+        return changed;
+    }
+
+
+    void ScriptComponentSystem::setHotReload(bool v)
+    {
+        if(v == hotReload()) return;
+        if(v)
+        {
+            _watcher = new QFileSystemWatcher(this);
+            connect(_watcher, &QFileSystemWatcher::fileChanged, this, &ScriptComponentSystem::fileChanged);
+            QStringList paths = _scripts.keys();
+            if(!paths.isEmpty())
+            {
+                _watcher->addPaths(paths);
+            }
+        }
+        else
+        {
+            delete _watcher;
+            _watcher = nullptr;
+        }
+    }
+
+
+    void ScriptComponentSystem::fileChanged(const QString& path)
+    {
+        // editors often replace files on save, which removes them from the watcher
+        if(!_watcher->files().contains(path) && QFile::exists(path))
+        {
+            _watcher->addPath(path);
+        }
+        reloadScript(path);
+    }
+}
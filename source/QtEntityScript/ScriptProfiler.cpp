@@ -0,0 +1,192 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntityScript/ScriptProfiler>
+
+#include <QtEntity/Profiler>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QScriptContext>
+#include <QScriptContextInfo>
+#include <QScriptEngine>
+
+namespace QtEntityScript
+{
+
+    ScriptProfiler::ScriptProfiler(QScriptEngine* engine)
+        : QScriptEngineAgent(engine)
+        , _clearedCalls(0)
+        , _frameBeginNs(0)
+        , _inFrame(false)
+        , _maxFrames(300)
+    {
+        engine->setAgent(this);
+    }
+
+
+    ScriptProfiler::~ScriptProfiler()
+    {
+        if(engine()->agent() == this)
+        {
+            engine()->setAgent(nullptr);
+        }
+    }
+
+
+    void ScriptProfiler::beginFrame()
+    {
+        _currentFrame.clear();
+        _frameBeginNs = QtEntity::Profiler::now();
+        _inFrame = true;
+    }
+
+
+    void ScriptProfiler::endFrame()
+    {
+        if(!_inFrame) return;
+        _inFrame = false;
+
+        Frame frame;
+        frame._beginNs = _frameBeginNs;
+        frame._endNs = QtEntity::Profiler::now();
+        frame._functions.reserve(_currentFrame.size());
+        for(auto i = _currentFrame.begin(); i != _currentFrame.end(); ++i)
+        {
+            frame._functions.push_back(i.value());
+        }
+        _currentFrame.clear();
+        QtEntity::Profiler::record("ScriptProfiler::frame", frame._beginNs, frame._endNs);
+
+        _frames.push_back(frame);
+        if(_frames.size() > _maxFrames)
+        {
+            _frames.remove(0, _frames.size() - _maxFrames);
+        }
+    }
+
+
+    void ScriptProfiler::beginZone(const QString& name)
+    {
+        enter(nameIndex(name));
+    }
+
+
+    void ScriptProfiler::endZone()
+    {
+        exit();
+    }
+
+
+    void ScriptProfiler::functionEntry(qint64 scriptId)
+    {
+        QScriptContextInfo info(engine()->currentContext());
+        QString name = info.functionName();
+        if(info.functionType() == QScriptContextInfo::ScriptFunction || scriptId != -1)
+        {
+            // script functions are identified by name and location
+            if(name.isEmpty())
+            {
+                name = (info.functionType() == QScriptContextInfo::ScriptFunction) ? "<anonymous>" : "<program>";
+            }
+            if(!info.fileName().isEmpty())
+            {
+                name += QString(" (%1:%2)").arg(QFileInfo(info.fileName()).fileName()).arg(info.functionStartLineNumber());
+            }
+        }
+        else if(name.isEmpty())
+        {
+            name = "<native>";
+        }
+        enter(nameIndex(name));
+    }
+
+
+    void ScriptProfiler::functionExit(qint64 scriptId, const QScriptValue& returnValue)
+    {
+        Q_UNUSED(scriptId)
+        Q_UNUSED(returnValue)
+        exit();
+    }
+
+
+    int ScriptProfiler::nameIndex(const QString& name)
+    {
+        auto i = _nameIndices.find(name);
+        if(i != _nameIndices.end())
+        {
+            return i.value();
+        }
+        int index = _names.size();
+        _names.push_back(name);
+        _zoneNames.push_back(QtEntity::Profiler::internName(name));
+        _nameIndices.insert(name, index);
+        return index;
+    }
+
+
+    void ScriptProfiler::enter(int name)
+    {
+        Call c;
+        c._name = name;
+        c._beginNs = QtEntity::Profiler::now();
+        _stack.push_back(c);
+    }
+
+
+    void ScriptProfiler::exit()
+    {
+        // exits without entry happen when profiler is installed during a call
+        if(_stack.isEmpty()) return;
+
+        qint64 now = QtEntity::Profiler::now();
+        Call c = _stack.back();
+        _stack.pop_back();
+
+        // call was entered before clear, drop it
+        if(_stack.size() < _clearedCalls)
+        {
+            _clearedCalls = _stack.size();
+            return;
+        }
+
+        qint64 duration = now - c._beginNs;
+        QtEntity::Profiler::record(_zoneNames[c._name], c._beginNs, now);
+
+        if(_inFrame)
+        {
+            FunctionStats& stats = _currentFrame[c._name];
+            stats._name = _names[c._name];
+            ++stats._calls;
+            stats._totalNs += duration;
+            stats._maxNs = qMax(stats._maxNs, duration);
+        }
+    }
+
+
+    bool ScriptProfiler::writeChromeTrace(QIODevice* device) const
+    {
+        return device->write(QtEntity::Profiler::chromeTrace()) != -1;
+    }
+
+
+    void ScriptProfiler::clear()
+    {
+        // running calls still return through exit, keep them on the stack to stay balanced
+        _clearedCalls = _stack.size();
+        _frames.clear();
+        _currentFrame.clear();
+    }
+}
@@ -0,0 +1,193 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntityScript/ScriptSystemRunner>
+
+#include <QtEntityScript/ScriptProfiler>
+#include <QtEntity/EntityManager>
+#include <QtEntity/EntitySystem>
+#include <QtEntity/PropertyTable>
+#include <QDebug>
+#include <QScriptEngine>
+
+namespace QtEntityScript
+{
+
+    ScriptSystemRunner::ScriptSystemRunner(QScriptEngine* engine, QtEntity::EntityManager* em, QObject* parent)
+        : QObject(parent)
+        , _engine(engine)
+        , _entityManager(em)
+        , _profiler(nullptr)
+    {
+    }
+
+
+    bool ScriptSystemRunner::addSystem(const QString& componentName, const QStringList& fields, const QScriptValue& function)
+    {
+        QtEntity::EntitySystem* es = _entityManager->system(componentName);
+        if(es == nullptr || !function.isFunction())
+        {
+            return false;
+        }
+
+        ScriptSystem s;
+        s._system = es;
+        s._fields = fields;
+        s._function = function;
+
+        const QtEntity::PropertyTable* table = es->propertyTable();
+        if(table != nullptr)
+        {
+            foreach(const QString& field, fields)
+            {
+                int index = table->indexOf(field);
+                if(index == -1)
+                {
+                    qWarning() << "Component" << componentName << "has no property" << field;
+                    return false;
+                }
+                s._indices.push_back(index);
+            }
+        }
+        _systems.push_back(s);
+        return true;
+    }
+
+
+    void ScriptSystemRunner::clear()
+    {
+        _systems.clear();
+    }
+
+
+    void ScriptSystemRunner::tick(double dt)
+    {
+        for(auto i = _systems.begin(); i != _systems.end(); ++i)
+        {
+            if(_profiler != nullptr)
+            {
+                _profiler->beginZone(i->_system->componentName() + "::tick");
+                run(*i, dt);
+                _profiler->endZone();
+            }
+            else
+            {
+                run(*i, dt);
+            }
+        }
+    }
+
+
+    void ScriptSystemRunner::run(const ScriptSystem& s, double dt)
+    {
+        const QtEntity::PropertyTable* table = s._system->propertyTable();
+        const int numFields = s._fields.size();
+
+        QScriptValue idArray = _engine->newArray(uint(s._system->count()));
+        QVector<QScriptValue> fieldArrays;
+        for(int f = 0; f < numFields; ++f)
+        {
+            fieldArrays.push_back(_engine->newArray(uint(s._system->count())));
+        }
+
+        // fill batch, remember values handed to script to detect changes
+        QVector<QtEntity::EntityId> ids;
+        QVector<QScriptValue> values;
+        ids.reserve(int(s._system->count()));
+        values.reserve(int(s._system->count()) * numFields);
+
+        QtEntity::PIterator end = s._system->pend();
+        for(QtEntity::PIterator i = s._system->pbegin(); i != end; ++i)
+        {
+            QtEntity::EntityId id = i.id();
+            if(id == 0) continue; // iterator does not provide entity ids
+            quint32 n = quint32(ids.size());
+            ids.push_back(id);
+            idArray.setProperty(n, QScriptValue(uint(id)));
+
+            if(table != nullptr)
+            {
+                for(int f = 0; f < numFields; ++f)
+                {
+                    QScriptValue v = _engine->toScriptValue(table->read(s._indices[f], *i));
+                    fieldArrays[f].setProperty(n, v);
+                    values.push_back(v);
+                }
+            }
+            else
+            {
+                QVariantMap m = s._system->toVariantMap(id);
+                for(int f = 0; f < numFields; ++f)
+                {
+                    QScriptValue v = _engine->toScriptValue(m.value(s._fields[f]));
+                    fieldArrays[f].setProperty(n, v);
+                    values.push_back(v);
+                }
+            }
+        }
+
+        QScriptValue batch = _engine->newObject();
+        batch.setProperty("length", QScriptValue(ids.size()));
+        batch.setProperty("ids", idArray);
+        for(int f = 0; f < numFields; ++f)
+        {
+            batch.setProperty(s._fields[f], fieldArrays[f]);
+        }
+
+        s._function.call(QScriptValue(), QScriptValueList() << batch << QScriptValue(dt));
+        if(_engine->hasUncaughtException())
+        {
+            qWarning() << "Error in script system" << s._system->componentName() << ":"
+                       << _engine->uncaughtException().toString();
+            _engine->clearExceptions();
+            return;
+        }
+
+        // script may have replaced the arrays
+        for(int f = 0; f < numFields; ++f)
+        {
+            fieldArrays[f] = batch.property(s._fields[f]);
+        }
+
+        // write back changed values
+        for(int n = 0; n < ids.size(); ++n)
+        {
+            void* component = s._system->component(ids[n]);
+            if(component == nullptr) continue;
+
+            QVariantMap changed;
+            for(int f = 0; f < numFields; ++f)
+            {
+                QScriptValue v = fieldArrays[f].property(quint32(n));
+                if(v.strictlyEquals(values[n * numFields + f])) continue;
+
+                if(table != nullptr)
+                {
+                    table->write(s._indices[f], component, v.toVariant());
+                }
+                else
+                {
+                    changed.insert(s._fields[f], v.toVariant());
+                }
+            }
+
+            if(!changed.isEmpty())
+            {
+                s._system->fromVariantMap(ids[n], changed);
+            }
+        }
+    }
+}
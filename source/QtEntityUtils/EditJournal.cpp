@@ -0,0 +1,262 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <QtEntityUtils/EditJournal>
+
+#include <QtEntityUtils/ItemList>
+#include <QtEntityUtils/VariantManager>
+#include <QtEntity/EntityManager>
+#include <QtEntity/EntitySystem>
+#include <QDataStream>
+#include <algorithm>
+
+namespace QtEntityUtils
+{
+
+    namespace
+    {
+        QByteArray encode(const QVariant& v)
+        {
+            QByteArray ret;
+            QDataStream stream(&ret, QIODevice::WriteOnly);
+            stream << v;
+            return ret;
+        }
+
+        QVariant decode(const QByteArray& data)
+        {
+            QDataStream stream(data);
+            QVariant v;
+            stream >> v;
+            return v;
+        }
+    }
+
+
+    EditJournal::EditJournal(int capacity, qint64 maxDataSize)
+        : _ring(qMax(1, capacity))
+        , _start(0)
+        , _size(0)
+        , _position(0)
+        , _dataSize(0)
+        , _maxDataSize(qMax(qint64(0), maxDataSize))
+        , _batchDepth(0)
+    {
+        // editor value types have to be streamable for storing them in the journal
+        qRegisterMetaTypeStreamOperators<QtEntityUtils::ItemList>("QtEntityUtils::ItemList");
+        qRegisterMetaTypeStreamOperators<QtEntityUtils::FilePath>("QtEntityUtils::FilePath");
+    }
+
+
+    EditJournal::~EditJournal()
+    {
+    }
+
+
+    void EditJournal::setCapacity(int capacity)
+    {
+        capacity = qMax(1, capacity);
+
+        // keep the newest entries
+        int keep = qMin(_size, capacity);
+        int dropped = _size - keep;
+        QVector<Entry> ring(capacity);
+        for(int i = 0; i < keep; ++i)
+        {
+            ring[i] = at(dropped + i);
+        }
+        for(int i = 0; i < dropped; ++i)
+        {
+            _dataSize -= entrySize(at(i));
+        }
+        _ring = ring;
+        _start = 0;
+        _size = keep;
+        _position = qMax(0, _position - dropped);
+    }
+
+
+    void EditJournal::setMaxDataSize(qint64 maxDataSize)
+    {
+        _maxDataSize = qMax(qint64(0), maxDataSize);
+        trimDataSize();
+    }
+
+
+    void EditJournal::beginBatch()
+    {
+        ++_batchDepth;
+    }
+
+
+    void EditJournal::endBatch()
+    {
+        Q_ASSERT(_batchDepth > 0);
+        if(--_batchDepth != 0) return;
+
+        // merged changes may have ended up at the old value
+        _batch.erase(std::remove_if(_batch.begin(), _batch.end(), [](const Change& c) {
+            return c._oldValue == c._newValue;
+        }), _batch.end());
+        _batchIndex.clear();
+
+        if(!_batch.isEmpty())
+        {
+            push(_batch);
+            _batch.clear();
+        }
+    }
+
+
+    void EditJournal::record(QtEntity::EntityId eid, int componentType, QtEntity::FieldId field,
+                             const QVariant& oldValue, const QVariant& newValue)
+    {
+        QByteArray newData = encode(newValue);
+        ChangeKey key((quint64(eid) << 32) | quint32(componentType), field);
+        auto existing = _batchIndex.find(key);
+        if(existing != _batchIndex.end())
+        {
+            // keep first old value, take latest new value
+            _batch[existing.value()]._newValue = newData;
+            return;
+        }
+
+        // edits that set a field to its current value are not undoable steps
+        QByteArray oldData = encode(oldValue);
+        if(oldData == newData) return;
+
+        Change c;
+        c._entity = eid;
+        c._componentType = componentType;
+        c._field = field;
+        c._oldValue = oldData;
+        c._newValue = newData;
+        _batch.push_back(c);
+
+        if(_batchDepth == 0)
+        {
+            push(_batch);
+            _batch.clear();
+        }
+        else
+        {
+            _batchIndex.insert(key, _batch.size() - 1);
+        }
+    }
+
+
+    void EditJournal::push(const Entry& entry)
+    {
+        // a new entry makes undone entries unreachable
+        while(_size > _position)
+        {
+            _dataSize -= entrySize(at(_size - 1));
+            at(_size - 1).clear();
+            --_size;
+        }
+
+        if(_size == _ring.size())
+        {
+            dropOldest();
+        }
+
+        at(_size) = entry;
+        _dataSize += entrySize(entry);
+        ++_size;
+        _position = _size;
+        trimDataSize();
+    }
+
+
+    void EditJournal::dropOldest()
+    {
+        _dataSize -= entrySize(at(0));
+        at(0).clear();
+        _start = (_start + 1) % _ring.size();
+        --_size;
+        _position = qMax(0, _position - 1);
+    }
+
+
+    void EditJournal::trimDataSize()
+    {
+        // keep at least the newest entry
+        while(_maxDataSize > 0 && _dataSize > _maxDataSize && _size > 1)
+        {
+            dropOldest();
+        }
+    }
+
+
+    bool EditJournal::undo(QtEntity::EntityManager& em)
+    {
+        if(!canUndo()) return false;
+        --_position;
+        apply(em, at(_position), true);
+        return true;
+    }
+
+
+    bool EditJournal::redo(QtEntity::EntityManager& em)
+    {
+        if(!canRedo()) return false;
+        apply(em, at(_position), false);
+        ++_position;
+        return true;
+    }
+
+
+    void EditJournal::apply(QtEntity::EntityManager& em, const Entry& entry, bool undo) const
+    {
+        // undo in reverse order so that changes of the same component are restored correctly
+        for(int i = 0; i < entry.size(); ++i)
+        {
+            const Change& c = entry[undo ? entry.size() - 1 - i : i];
+            QtEntity::EntitySystem* es = em.system(c._componentType);
+            if(es == nullptr || es->component(c._entity) == nullptr) continue;
+            QtEntity::PropertyBag bag;
+            bag.insert(c._field, decode(undo ? c._oldValue : c._newValue));
+            es->fromPropertyBag(c._entity, bag);
+        }
+    }
+
+
+    void EditJournal::clear()
+    {
+        for(int i = 0; i < _size; ++i)
+        {
+            at(i).clear();
+        }
+        _start = 0;
+        _size = 0;
+        _position = 0;
+        _dataSize = 0;
+        _batch.clear();
+        _batchIndex.clear();
+    }
+
+
+    qint64 EditJournal::entrySize(const Entry& entry)
+    {
+        qint64 s = 0;
+        for(auto i = entry.begin(); i != entry.end(); ++i)
+        {
+            s += i->_oldValue.size() + i->_newValue.size();
+        }
+        return s;
+    }
+}
@@ -18,9 +18,13 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <QtEntity/EntityManager>
 #include <QtEntity/EntitySystem>
+#include <QtEntity/PropertyPath>
+#include <QtEntity/PropertyTable>
+#include <QtEntityUtils/EditJournal>
 #include <QtEntityUtils/ItemList>
 #include <QtEntityUtils/VariantFactory>
 #include <QtEntityUtils/VariantManager>
+#include <QApplication>
 #include <QDate>
 #include <QDebug>
 #include <QFile>
@@ -29,69 +33,33 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <QMenu>
 #include <QMetaProperty>
 #include <QUuid>
-#include <qttreepropertybrowser.h>
+#include <qtmodelpropertybrowser.h>
 #include <QMessageBox>
+#include <QTimer>
+#include <algorithm>
 
 namespace QtEntityUtils
 {
-    bool findSubProperty(QtProperty *property, QtProperty *toFind)
+    // needed for comparing item lists stored in variants
+    static void registerItemListComparator()
     {
-        if(toFind == property) return true;
-        foreach(auto prop, property->subProperties())
-        {
-            if(findSubProperty(prop, toFind))
-            {
-                return true;
-            }
-        }
-        return false;
-    }
-
-    QtProperty* findComponentProperty(QtTreePropertyBrowser* editor, QtProperty *property)
-    {
-        QList<QtBrowserItem *> items = editor->topLevelItems();
-        foreach(auto item, items)
-        {
-            if(findSubProperty(item->property(), property))
-            {
-                return item->property();
-            }
-        }
-        return nullptr;
-    }
-
-
-
-    QtProperty* findParentPropertyRec(const QtProperty* property, QtProperty* tree)
-    {
-        QList<QtProperty *> items = tree->subProperties();
-        foreach(auto item, items)
-        {
-            if(item == property) return tree;
-            QtProperty* parent = findParentPropertyRec(property, item);
-            if(parent) return parent;
-        }
-        return nullptr;
+        static bool registered = QMetaType::registerEqualsComparator<ItemList>();
+        Q_UNUSED(registered)
     }
 
-    QtProperty* findParentProperty(QtTreePropertyBrowser* editor, const QtProperty *property)
-    {
-        QList<QtBrowserItem *> items = editor->topLevelItems();
-        foreach(auto item, items)
-        {
-            if(item->property() == property) return nullptr;
-            QtProperty* parent = findParentPropertyRec(property, item->property());
-            if(parent) return parent;
-        }
-        return nullptr;
-    }
 
     EntityEditor::EntityEditor()
         : _entityId(0)
         , _variantManager(new VariantManager(this))
-        , _editor(new QtTreePropertyBrowser(this))
+        , _editor(new QtModelPropertyBrowser(this))
         , _ignorePropertyChanges(false)
+        , _fieldPatchesEnabled(false)
+        , _liveEntityManager(nullptr)
+        , _liveTimer(new QTimer(this))
     {
+        // needed for comparing displayed values with live values
+        registerItemListComparator();
+        connect(_liveTimer, &QTimer::timeout, this, &EntityEditor::refreshLiveValues);
 
         VariantFactory* variantFactory = new VariantFactory();
 
@@ -103,7 +71,7 @@ namespace QtEntityUtils
         _editor->setPropertiesWithoutValueMarked(false);
         _editor->setRootIsDecorated(false);
         _editor->setContextMenuPolicy(Qt::CustomContextMenu);
-        _editor->setResizeMode(QtTreePropertyBrowser::Interactive);
+        _editor->setResizeMode(QtModelPropertyBrowser::Interactive);
         connect(_editor, &QWidget::customContextMenuRequested, this, &EntityEditor::showContextMenu);
         
         QHBoxLayout* l = new QHBoxLayout();
@@ -115,6 +83,64 @@ namespace QtEntityUtils
 
         connect(_variantManager, &VariantManager::valueChanged, this, &EntityEditor::propertyValueChanged);
 
+        // keep parent index up to date
+        connect(_variantManager, &VariantManager::propertyInserted, [this](QtProperty* prop, QtProperty* parent, QtProperty*) {
+            if(parent) _parents[prop] = parent;
+        });
+        connect(_variantManager, &VariantManager::propertyRemoved, [this](QtProperty* prop, QtProperty* parent) {
+            if(_parents.value(prop) == parent) _parents.remove(prop);
+        });
+        connect(_variantManager, &VariantManager::propertyDestroyed, [this](QtProperty* prop) {
+            _parents.remove(prop);
+            _shownLists.remove(prop);
+            _pendingLists.remove(prop);
+        });
+
+        // entries of list properties are created when the list is expanded.
+        // Deferred because the browser also expands items while inserting them
+        connect(_editor, &QtModelPropertyBrowser::expanded, [this](QtBrowserItem* item) {
+            QtVariantProperty* prop = static_cast<QtVariantProperty*>(item->property());
+            if(prop->propertyType() != VariantManager::listId() || _shownLists.contains(prop))
+            {
+                return;
+            }
+            if(_pendingLists.isEmpty())
+            {
+                QTimer::singleShot(0, this, [this]() { showPendingListPages(); });
+            }
+            _pendingLists.insert(prop);
+        });
+    }
+
+
+    QtProperty* EntityEditor::componentProperty(QtProperty* property) const
+    {
+        // components are top level properties
+        QtProperty* parent = _parents.value(property);
+        while(parent)
+        {
+            property = parent;
+            parent = _parents.value(property);
+        }
+        return property;
+    }
+
+
+    void EntityEditor::deletePropertyTree(QtProperty* property)
+    {
+        // deleting a property does not delete the sub properties the editor added
+        // to groups and lists. Sub properties of compound values like QColor or
+        // QPointF belong to the variant manager, it deletes them with their parent.
+        int type = _variantManager->propertyType(property);
+        if(type == QtVariantPropertyManager::groupTypeId() || type == VariantManager::listId())
+        {
+            foreach(QtProperty* sub, property->subProperties())
+            {
+                property->removeSubProperty(sub);
+                deletePropertyTree(sub);
+            }
+        }
+        delete property;
     }
 
     QVariant toVariant(const QtProperty* prop)
@@ -150,16 +176,13 @@ namespace QtEntityUtils
 
         if(prop->propertyType() == VariantManager::listId())
         {
+            QMenu menu(this);
+            int numentries = _variantManager->value(prop).value<ItemList>().size();
             int maxentries = _variantManager->attributeValue(prop, "maxentries").toInt();
-            if(prop->subProperties().size() >= maxentries)
-            {
-                return;
-            }
-            QVariant prototypes = _variantManager->attributeValue(prop, "prototypes");
-            QVariantList protos = prototypes.toList();
-            if(!protos.isEmpty())
+            if(numentries < maxentries)
             {
-                QMenu menu(this);
+                QVariant prototypes = _variantManager->attributeValue(prop, "prototypes");
+                QVariantList protos = prototypes.toList();
                 foreach(QVariant prototype, protos)
                 {
                     QAction* action = menu.addAction(QString("Add %1").arg(prototype.toString()));
@@ -168,10 +191,32 @@ namespace QtEntityUtils
                         this->addListItem(prototype.toString(), prop);
                     });
                 }
+            }
+
+            // page through large lists
+            int pagesize = _variantManager->attributeValue(prop, "pagesize").toInt();
+            int offset = _variantManager->listOffset(prop);
+            if(offset > 0)
+            {
+                QAction* action = menu.addAction("Show previous entries");
+                connect(action, &QAction::triggered, [this, prop, offset, pagesize]() {
+                    this->showListPage(prop, offset - pagesize);
+                });
+            }
+            if(offset + pagesize < numentries)
+            {
+                QAction* action = menu.addAction("Show next entries");
+                connect(action, &QAction::triggered, [this, prop, offset, pagesize]() {
+                    this->showListPage(prop, offset + pagesize);
+                });
+            }
+
+            if(!menu.isEmpty())
+            {
                 menu.exec(_editor->mapToGlobal(pos));
             }
         }
-        QtVariantProperty* parent = dynamic_cast<QtVariantProperty*>(findParentProperty(_editor, prop));
+        QtVariantProperty* parent = dynamic_cast<QtVariantProperty*>(parentProperty(prop));
         if(parent && parent->propertyType() == VariantManager::listId())
         {
             QMenu menu(this);
@@ -201,9 +246,26 @@ namespace QtEntityUtils
         QVariantMap prototypeAttributes = typeentry["attributes"].toMap();        
 
         _ignorePropertyChanges = true;
-        QtVariantProperty* item = this->addWidgetsRecursively(prototypename, prototype, prototypeAttributes);
-        item->setAttribute("prototype", prototypename);
-        prop->addSubProperty(item);
+
+        ItemList items = _variantManager->value(prop).value<ItemList>();
+        int index = items.size();
+        items.push_back(Item(prototypename, prototype));
+        _variantManager->setListItems(prop, items);
+
+        int pagesize = _variantManager->attributeValue(prop, "pagesize").toInt();
+        int offset = _variantManager->listOffset(prop);
+        if(_shownLists.contains(prop) && index < offset + pagesize)
+        {
+            QtVariantProperty* item = this->addWidgetsRecursively(prototypename, prototype, prototypeAttributes);
+            item->setAttribute("prototype", prototypename);
+            prop->addSubProperty(item);
+            collapseCollapsedEntries(_editor->items(item));
+        }
+        else
+        {
+            // show page containing the new entry
+            showListPage(prop, index);
+        }
 
         _ignorePropertyChanges = false;
 
@@ -216,11 +278,23 @@ namespace QtEntityUtils
     void EntityEditor::removeListItem(QtVariantProperty* prop)
     {
         _ignorePropertyChanges = true;
-        QtVariantProperty* parent = dynamic_cast<QtVariantProperty*>(
-                findParentProperty(_editor, prop));
+        QtVariantProperty* parent = dynamic_cast<QtVariantProperty*>(parentProperty(prop));
         Q_ASSERT(parent);
+
+        ItemList items = _variantManager->value(parent).value<ItemList>();
+        int offset = _variantManager->listOffset(parent);
+        items.removeAt(offset + parent->subProperties().indexOf(prop));
+
         parent->removeSubProperty(prop);
-        delete prop;
+        deletePropertyTree(prop);
+        _variantManager->setListItems(parent, items);
+
+        // removed last entry of page, go to previous page
+        if(parent->subProperties().isEmpty() && offset > 0)
+        {
+            int pagesize = _variantManager->attributeValue(parent, "pagesize").toInt();
+            showListPage(parent, offset - pagesize);
+        }
 
         _ignorePropertyChanges = false;
 
@@ -229,6 +303,220 @@ namespace QtEntityUtils
     }
 
 
+    int EntityEditor::editorTypeId(const QVariant& data, const QVariantMap& attributes)
+    {
+        // hack to detect enums
+        if(attributes.contains("enumNames"))
+        {
+            return VariantManager::enumTypeId();
+        }
+        // VariantManager edits floats as doubles
+        if(data.userType() == qMetaTypeId<float>())
+        {
+            return qMetaTypeId<double>();
+        }
+        return data.userType();
+    }
+
+
+    QVariantMap EntityEditor::listEntryAttributes(const QString& prototype) const
+    {
+        if(_types.contains(prototype))
+        {
+            QVariantMap t = _types[prototype].toMap();
+            if(t.contains("attributes"))
+            {
+                return t["attributes"].toMap();
+            }
+        }
+        return QVariantMap();
+    }
+
+
+    void EntityEditor::insertSorted(QtVariantProperty* parent, QtVariantProperty* prop)
+    {
+        if(parent->subProperties().empty())
+        {
+            parent->addSubProperty(prop);
+            return;
+        }
+
+        // insert sorted by order property
+        int enterorder = _variantManager->attributeValue(prop, "order").toInt();
+
+        QtProperty* before = nullptr;
+        for(QtProperty* sub : parent->subProperties())
+        {
+            int suborder = _variantManager->attributeValue(sub, "order").toInt();
+            if(suborder >= enterorder)
+            {
+                break;
+            }
+            else
+            before = sub;
+        }
+        parent->insertSubProperty(prop, before);
+    }
+
+
+    void EntityEditor::replaceSubProperty(QtProperty* parent, QtProperty* old, QtVariantProperty* replacement)
+    {
+        if(replacement)
+        {
+            parent->insertSubProperty(replacement, old);
+        }
+        parent->removeSubProperty(old);
+        deletePropertyTree(old);
+    }
+
+
+    bool EntityEditor::updateWidgetsRecursively(QtVariantProperty* prop,
+                                                const QVariant& data,
+                                                const QVariantMap& attributes)
+    {
+        if(data.type() == QVariant::Map)
+        {
+            if(prop->propertyType() != QtVariantPropertyManager::groupTypeId()) return false;
+
+            QVariantMap props = data.toMap();
+            QHash<QString, QtProperty*> subs;
+
+            // remove entries that are no longer in data
+            foreach(QtProperty* sub, prop->subProperties())
+            {
+                if(props.contains(sub->propertyName()))
+                {
+                    subs[sub->propertyName()] = sub;
+                }
+                else
+                {
+                    prop->removeSubProperty(sub);
+                    deletePropertyTree(sub);
+                }
+            }
+
+            for(auto i = props.begin(); i != props.end(); ++i)
+            {
+                QVariantMap subattribs = attributes[i.key()].toMap();
+                QtVariantProperty* sub = static_cast<QtVariantProperty*>(subs.value(i.key()));
+                if(sub && updateWidgetsRecursively(sub, i.value(), subattribs))
+                {
+                    continue;
+                }
+
+                // new entry or shape changed: create new editor
+                QtVariantProperty* created = this->addWidgetsRecursively(i.key(), i.value(), subattribs);
+                if(sub)
+                {
+                    replaceSubProperty(prop, sub, created);
+                }
+                else if(created)
+                {
+                    insertSorted(prop, created);
+                }
+                if(created)
+                {
+                    collapseCollapsedEntries(_editor->items(created));
+                }
+            }
+            return true;
+        }
+
+        if(data.userType() == VariantManager::listId())
+        {
+            if(prop->propertyType() != VariantManager::listId()) return false;
+
+            ItemList items = data.value<ItemList>();
+            QList<QtProperty*> subs = prop->subProperties();
+            int offset = _variantManager->listOffset(prop);
+
+            if(!_shownLists.contains(prop) || (offset > 0 && offset >= items.size()))
+            {
+                foreach(QtProperty* sub, subs)
+                {
+                    prop->removeSubProperty(sub);
+                    deletePropertyTree(sub);
+                }
+                _variantManager->setListItems(prop, items);
+                if(_shownLists.contains(prop))
+                {
+                    // shown page no longer exists, show last page
+                    showListPage(prop, items.size() - 1);
+                }
+                else
+                {
+                    foreach(QtBrowserItem* item, _editor->items(prop))
+                    {
+                        _editor->setChildIndicatorShown(item, !items.isEmpty());
+                    }
+                }
+                return true;
+            }
+
+            _variantManager->setListItems(prop, items);
+
+            // update entries of shown page in place, replace entries with different prototype
+            int pagesize = _variantManager->attributeValue(prop, "pagesize").toInt();
+            int end = qMin(items.size(), offset + pagesize);
+            int common = qMin(end - offset, subs.size());
+            for(int i = 0; i < common; ++i)
+            {
+                const Item& item = items[offset + i];
+                QtVariantProperty* sub = static_cast<QtVariantProperty*>(subs[i]);
+                QVariantMap entryattrs = listEntryAttributes(item._prototype);
+                if(_variantManager->attributeValue(sub, "prototype").toString() == item._prototype &&
+                   updateWidgetsRecursively(sub, item._value, entryattrs))
+                {
+                    continue;
+                }
+                QtVariantProperty* created = this->addWidgetsRecursively(item._prototype, item._value, entryattrs);
+                if(created)
+                {
+                    created->setAttribute("prototype", item._prototype);
+                }
+                replaceSubProperty(prop, sub, created);
+                if(created)
+                {
+                    collapseCollapsedEntries(_editor->items(created));
+                }
+            }
+
+            for(int i = common; i < subs.size(); ++i)
+            {
+                prop->removeSubProperty(subs[i]);
+                deletePropertyTree(subs[i]);
+            }
+
+            QList<QtProperty*> added;
+            for(int i = offset + common; i < end; ++i)
+            {
+                const Item& item = items[i];
+                QtVariantProperty* created = this->addWidgetsRecursively(item._prototype, item._value,
+                                                                         listEntryAttributes(item._prototype));
+                if(created)
+                {
+                    created->setAttribute("prototype", item._prototype);
+                    added.push_back(created);
+                }
+            }
+            subs = prop->subProperties();
+            prop->insertSubProperties(added, subs.isEmpty() ? nullptr : subs.last());
+            foreach(QtProperty* created, added)
+            {
+                collapseCollapsedEntries(_editor->items(created));
+            }
+            return true;
+        }
+
+        if(prop->propertyType() != editorTypeId(data, attributes)) return false;
+        if(_variantManager->value(prop) != data)
+        {
+            prop->setValue(data);
+        }
+        return true;
+    }
+
+
     QtVariantProperty* EntityEditor::addWidgetsRecursively(const QString& name,
                                                     const QVariant& data,
                                                     const QVariantMap& attributes)
@@ -246,37 +534,23 @@ namespace QtEntityUtils
                 createdprop->setAttribute(k.key(), k.value());
             }
 
+            // insert all entries at once, sorted by order attribute.
+            // Same order as inserting each with insertSorted
+            QList<QtProperty*> subs;
             for(auto i = props.begin(); i != props.end(); ++i)
             {
                 QVariantMap subattribs = attributes[i.key()].toMap();
                 auto prop = this->addWidgetsRecursively(i.key(), i.value(), subattribs);
                 if(prop)
                 {
-                    if(createdprop->subProperties().empty())
-                    {
-                        createdprop->addSubProperty(prop);
-                    } 
-                    else
-                    {
-                        // insert sorted by order property
-
-                        int enterorder = _variantManager->attributeValue(prop, "order").toInt();
-
-                        QtProperty* before = nullptr;
-                        for(QtProperty* sub : createdprop->subProperties())
-                        {
-                            int suborder = _variantManager->attributeValue(sub, "order").toInt();
-                            if(suborder >= enterorder)
-                            {
-                                break;
-                            }
-                            else
-                            before = sub;
-                        }                        
-                        createdprop->insertSubProperty(prop, before);                       
-                    }                    
+                    subs.push_front(prop);
                 }
             }
+            std::stable_sort(subs.begin(), subs.end(), [this](QtProperty* a, QtProperty* b) {
+                return _variantManager->attributeValue(a, "order").toInt() <
+                       _variantManager->attributeValue(b, "order").toInt();
+            });
+            createdprop->insertSubProperties(subs, nullptr);
         }
         else if(data.userType() == VariantManager::listId())
         {
@@ -289,40 +563,12 @@ namespace QtEntityUtils
                 createdprop->setAttribute(k.key(), k.value());
             }
 
-            foreach(const Item& item, items)
-            {               
-                QVariantMap entryattrs;
-
-                if(_types.contains(item._prototype))
-                {
-                    QVariantMap t = _types[item._prototype].toMap();
-                    if(t.contains("attributes"))
-                    {
-                        entryattrs = t["attributes"].toMap();
-                    }
-                }
-
-                QtVariantProperty* prop = this->addWidgetsRecursively(item._prototype, item._value, entryattrs);
-                
-                if(prop)
-                {
-                    prop->setAttribute("prototype", item._prototype);
-                    createdprop->addSubProperty(prop);
-                }
-            }
+            // sub properties for the entries are created when the list is expanded
+            _variantManager->setListItems(createdprop, items);
         }
         else
         {
-            int tid = data.userType();
-
-            // hack to detect enums
-            if(attributes.contains("enumNames"))
-            {
-                tid = VariantManager::enumTypeId();
-            }
-            
-
-            createdprop = _variantManager->addProperty(tid, name);
+            createdprop = _variantManager->addProperty(editorTypeId(data, attributes), name);
             // set property attributes
             
             for(auto k = attributes.begin(); k != attributes.end(); ++k)
@@ -351,19 +597,64 @@ namespace QtEntityUtils
                                      const QVariantMap& attributes,
                                      const QStringList& availableComponents)
     {
+        displayEntities(QList<QtEntity::EntityId>() << id, data, attributes, availableComponents);
+    }
+
+
+    void EntityEditor::displayEntities(const QList<QtEntity::EntityId>& ids,
+                                       const QVariantMap& data,
+                                       const QVariantMap& attributes,
+                                       const QStringList& availableComponents)
+    {
+        Q_UNUSED(availableComponents)
+
+        if(ids.isEmpty())
+        {
+            clear();
+            _entityIds.clear();
+            _entityId = 0;
+            return;
+        }
+
         // changing property editors triggers signals which cause the component to be updated in the game.
         // ignore these signals while initially creating the property editors
         _ignorePropertyChanges = true;
-        _entityId = id;
-        clear();     
+
+        // when showing different entities, rebuild everything.
+        // Else only update changed values and rebuild components whose structure changed.
+        if(ids != _entityIds)
+        {
+            clear();
+        }
+        _editor->beginUpdate();
+        _entityIds = ids;
+        _entityId = ids.first();
 
         _types = QVariantMap();
+        _displayedData = data;
 
         if(attributes.contains("__types"))
         {
             _types.unite(attributes["__types"].toMap());
         }
 
+        // components currently shown, by name
+        QHash<QString, QtProperty*> shown;
+        foreach(QtProperty* prop, _editor->properties())
+        {
+            if(data.contains(prop->propertyName()))
+            {
+                shown[prop->propertyName()] = prop;
+            }
+            else
+            {
+                _editor->removeProperty(prop);
+                _componentAttributes.remove(prop->propertyName());
+                deletePropertyTree(prop);
+            }
+        }
+
+        QtProperty* previous = nullptr;
         for(auto i = data.begin(); i != data.end(); ++i)
         {
             QVariantMap attrs = attributes.value(i.key(), QVariantMap()).toMap();
@@ -373,26 +664,117 @@ namespace QtEntityUtils
                 _types.unite(attrs["__types"].toMap());
             }
 
+            QtVariantProperty* existing = static_cast<QtVariantProperty*>(shown.value(i.key()));
+            if(existing && _componentAttributes.value(i.key()) == attrs &&
+               updateWidgetsRecursively(existing, i.value(), attrs))
+            {
+                previous = existing;
+                continue;
+            }
 
             auto item = this->addWidgetsRecursively(i.key(), i.value(), attrs);
+            if(existing)
+            {
+                _editor->removeProperty(existing);
+                deletePropertyTree(existing);
+            }
             if(item)
             {
-                _editor->addProperty(item);
-
-                collapseCollapsedEntries(_editor->topLevelItems());
+                _editor->insertProperty(item, previous);
+                _componentAttributes[i.key()] = attrs;
+                collapseCollapsedEntries(_editor->items(item));
+                previous = item;
             }
         }
+        _editor->endUpdate();
         _ignorePropertyChanges = false;
     }
 
 
     void EntityEditor::clear()
     {
+        _displayedData.clear();
+        _componentAttributes.clear();
+        _parents.clear();
+        _shownLists.clear();
+        _pendingLists.clear();
         _variantManager->clear();
         _editor->clear();
     }
 
 
+    void EntityEditor::setLiveUpdate(QtEntity::EntityManager* em, int intervalMs)
+    {
+        _liveEntityManager = em;
+        if(em)
+        {
+            _liveTimer->start(qMax(intervalMs, 33));
+        }
+        else
+        {
+            _liveTimer->stop();
+        }
+    }
+
+
+    void EntityEditor::refreshLiveValues()
+    {
+        if(_liveEntityManager == nullptr || _entityId == 0 || _entityIds.size() > 1) return;
+
+        // do not overwrite values the user is currently editing
+        QWidget* focus = QApplication::focusWidget();
+        if(focus && _editor->isAncestorOf(focus)) return;
+
+        // collect changed components, check if components were added or removed
+        QVariantMap changed;
+        bool structureChanged = false;
+        for(auto i = _liveEntityManager->begin(); i != _liveEntityManager->end(); ++i)
+        {
+            QtEntity::EntitySystem* es = i->second;
+            QString name = es->componentName();
+            bool hasComponent = (es->component(_entityId) != nullptr);
+            if(hasComponent != _displayedData.contains(name))
+            {
+                structureChanged = true;
+                break;
+            }
+            if(!hasComponent) continue;
+
+            QVariantMap values = es->toVariantMap(_entityId);
+            if(values != _displayedData[name].toMap())
+            {
+                changed[name] = values;
+            }
+        }
+
+        if(!structureChanged && !changed.isEmpty())
+        {
+            _ignorePropertyChanges = true;
+            foreach(QtProperty* prop, _editor->properties())
+            {
+                auto i = changed.find(prop->propertyName());
+                if(i == changed.end()) continue;
+                QVariantMap attrs = _componentAttributes.value(i.key()).toMap();
+                if(!updateWidgetsRecursively(static_cast<QtVariantProperty*>(prop), i.value(), attrs))
+                {
+                    structureChanged = true;
+                    break;
+                }
+                _displayedData[i.key()] = i.value();
+            }
+            _ignorePropertyChanges = false;
+        }
+
+        if(structureChanged)
+        {
+            QVariantMap components, attributes;
+            QStringList available;
+            fetchEntityData(*_liveEntityManager, _entityId, components, attributes, available);
+            displayEntity(_entityId, components, attributes, available);
+        }
+    }
+
+
     void EntityEditor::fetchEntityData(const QtEntity::EntityManager& em,
                                        QtEntity::EntityId eid,
                                        QVariantMap& components,
@@ -415,45 +797,317 @@ namespace QtEntityUtils
     }
 
 
-    void EntityEditor::applyEntityData(QtEntity::EntityManager& em, QtEntity::EntityId eid, const QVariantMap& values)
+    // conversion context of values applied by the static edit functions.
+    // Journal old values are read in the same context, so undo restores what was changed
+    static const int APPLY_CONTEXT = QtEntity::EntitySystem::CREATION;
+
+
+    // read current value of a single field, for recording it in the edit journal.
+    // Systems with a property table read only that field instead of the whole component
+    static QVariant readField(QtEntity::EntitySystem* es, QtEntity::EntityId eid, QtEntity::FieldId field)
     {
+        const QtEntity::PropertyTable* table = es->propertyTable();
+        if(table != nullptr)
+        {
+            int index = table->indexOfField(field);
+            void* c = es->component(eid);
+            if(index != -1 && c != nullptr) return table->read(index, c);
+        }
+        return es->toVariantMap(eid, APPLY_CONTEXT).value(QtEntity::FieldNames::name(field));
+    }
+
+
+    void EntityEditor::applyEntityData(QtEntity::EntityManager& em, QtEntity::EntityId eid, const QVariantMap& values, EditJournal* journal)
+    {
+        QTENTITY_PROFILE_ZONE("EntityEditor::applyEntityData");
+        if(journal) journal->beginBatch();
         foreach(const QString &componenttype, values.keys())
         {
             QtEntity::EntitySystem* es = em.system(componenttype);
             if(es == nullptr)
             {
                 qDebug() << "Could not apply entity data, no entity system of type " << componenttype;
+                break;
+            }
+            QVariantMap componentvalues = values.value(componenttype).toMap();
+            if(journal)
+            {
+                for(auto i = componentvalues.begin(); i != componentvalues.end(); ++i)
+                {
+                    QtEntity::FieldId field = QtEntity::FieldNames::intern(i.key());
+                    journal->record(eid, es->componentType(), field, readField(es, eid, field), i.value());
+                }
+            }
+            es->fromVariantMap(eid, componentvalues, APPLY_CONTEXT);
+        }
+        if(journal) journal->endBatch();
+    }
+
+
+    // set attribute "mixed" on fields of values that differ from other.
+    // Sub fields of map values get their own attribute, so editing one
+    // sub field can tell whether the other ones differ
+    static void markMixedValues(const QVariantMap& values, const QVariantMap& other, QVariantMap& attrs)
+    {
+        for(auto k = values.begin(); k != values.end(); ++k)
+        {
+            QVariant o = other.value(k.key());
+            if(o == k.value()) continue;
+
+            QVariantMap fieldattrs = attrs.value(k.key()).toMap();
+            fieldattrs["mixed"] = true;
+            if(k.value().type() == QVariant::Map && o.type() == QVariant::Map)
+            {
+                markMixedValues(k.value().toMap(), o.toMap(), fieldattrs);
+            }
+            attrs[k.key()] = fieldattrs;
+        }
+    }
+
+
+    void EntityEditor::fetchEntitiesData(const QtEntity::EntityManager& em,
+                                         const QList<QtEntity::EntityId>& ids,
+                                         QVariantMap& components,
+                                         QVariantMap& attributes,
+                                         QStringList& availableComponents)
+    {
+        if(ids.isEmpty()) return;
+        registerItemListComparator();
+
+        for(auto i = em.begin(); i != em.end(); ++i)
+        {
+            QtEntity::EntitySystem* es = i->second;
+
+            // only components all entities have are shown
+            bool shared = true;
+            foreach(QtEntity::EntityId id, ids)
+            {
+                if(!es->component(id))
+                {
+                    shared = false;
+                    break;
+                }
+            }
+            if(!shared)
+            {
+                availableComponents.push_back(es->componentName());
+                continue;
+            }
+
+            // show values of first entity, mark values that differ in other entities
+            QVariantMap values = es->toVariantMap(ids.first());
+            QVariantMap attrs = es->editingAttributes();
+            for(auto j = ids.begin() + 1; j != ids.end(); ++j)
+            {
+                markMixedValues(values, es->toVariantMap(*j), attrs);
+            }
+            components[es->componentName()] = values;
+            attributes[es->componentName()] = attrs;
+        }
+    }
+
+
+    void EntityEditor::applyEntitiesData(QtEntity::EntityManager& em,
+                                         const QList<QtEntity::EntityId>& ids,
+                                         const QVariantMap& values,
+                                         EditJournal* journal)
+    {
+        QTENTITY_PROFILE_ZONE("EntityEditor::applyEntitiesData");
+        if(journal) journal->beginBatch();
+        for(auto c = values.begin(); c != values.end(); ++c)
+        {
+            QtEntity::EntitySystem* es = em.system(c.key());
+            if(es == nullptr)
+            {
+                qDebug() << "Could not apply entity data, no entity system of type " << c.key();
+                break;
+            }
+
+            // field names are interned once for all entities
+            QVariantMap componentvalues = c.value().toMap();
+            QtEntity::PropertyBag bag(componentvalues);
+            if(journal)
+            {
+                foreach(QtEntity::EntityId eid, ids)
+                {
+                    if(!es->component(eid)) continue;
+                    for(auto i = bag.begin(); i != bag.end(); ++i)
+                    {
+                        journal->record(eid, es->componentType(), i->_field,
+                                        readField(es, eid, i->_field), i->_value);
+                    }
+                }
+            }
+            es->fromPropertyBagForAll(ids, bag, APPLY_CONTEXT);
+        }
+        if(journal) journal->endBatch();
+    }
+
+
+    // apply patch to a single entity. System lookup and path parsing are
+    // done by the caller, so they happen only once when patching many entities
+    static void patchEntity(QtEntity::EntitySystem* es,
+                            QtEntity::EntityId eid,
+                            const QtEntity::PropertyPath& path,
+                            QtEntity::FieldId field,
+                            const QVariant& value,
+                            EditJournal* journal)
+    {
+        QVariant oldValue;
+        if(journal)
+        {
+            oldValue = readField(es, eid, field);
+        }
+
+        if(!es->applyPatch(eid, path, value, APPLY_CONTEXT))
+        {
+            // system does not handle patch, patch field value and reassign it
+            QVariant fieldValue = journal ? oldValue : readField(es, eid, field);
+            if(!setValueAtPath(fieldValue, path, 1, value))
+            {
+                qDebug() << "Could not apply entity patch, path not found: " << path.toString();
                 return;
             }
-            es->fromVariantMap(eid, values.value(componenttype).toMap());
+            QVariantMap m;
+            m.insert(path.field(), fieldValue);
+            es->fromVariantMap(eid, m, APPLY_CONTEXT);
+        }
+
+        if(journal)
+        {
+            journal->record(eid, es->componentType(), field, oldValue, readField(es, eid, field));
+        }
+    }
+
+
+    void EntityEditor::applyEntityPatch(QtEntity::EntityManager& em,
+                                        QtEntity::EntityId eid,
+                                        const QString& componentName,
+                                        const QString& path,
+                                        const QVariant& value,
+                                        EditJournal* journal)
+    {
+        applyEntitiesPatch(em, QList<QtEntity::EntityId>() << eid, componentName, path, value, journal);
+    }
+
+
+    void EntityEditor::applyEntitiesPatch(QtEntity::EntityManager& em,
+                                          const QList<QtEntity::EntityId>& ids,
+                                          const QString& componentName,
+                                          const QString& path,
+                                          const QVariant& value,
+                                          EditJournal* journal)
+    {
+        QTENTITY_PROFILE_ZONE("EntityEditor::applyEntitiesPatch");
+        QtEntity::EntitySystem* es = em.system(componentName);
+        if(es == nullptr)
+        {
+            qDebug() << "Could not apply entity patch, no entity system of type " << componentName;
+            return;
+        }
+        QtEntity::PropertyPath p(path);
+        if(p.isEmpty())
+        {
+            qDebug() << "Could not apply entity patch, invalid path " << path;
+            return;
+        }
+        QtEntity::FieldId field = QtEntity::FieldNames::intern(p.field());
+
+        if(journal) journal->beginBatch();
+        foreach(QtEntity::EntityId eid, ids)
+        {
+            if(es->component(eid) != nullptr)
+            {
+                patchEntity(es, eid, p, field, value, journal);
+            }
+        }
+        if(journal) journal->endBatch();
+    }
+
+
+    bool EntityEditor::propertyPath(QtProperty* property, QtProperty* component, QtEntity::PropertyPath& path) const
+    {
+        QList<QtProperty*> chain;
+        for(QtProperty* p = property; p != component; p = _parents.value(p))
+        {
+            if(p == nullptr) return false;
+            chain.push_front(p);
+        }
+
+        QtProperty* parent = component;
+        foreach(QtProperty* p, chain)
+        {
+            int parentType = _variantManager->propertyType(parent);
+            if(parent == component || parentType == QtVariantPropertyManager::groupTypeId())
+            {
+                path.appendName(p->propertyName());
+            }
+            else if(parentType == VariantManager::listId())
+            {
+                path.appendIndex(_variantManager->listOffset(parent) + parent->subProperties().indexOf(p));
+            }
+            else
+            {
+                return false;
+            }
+            parent = p;
         }
+        return !path.isEmpty();
     }
 
+
     void EntityEditor::propertyValueChanged(QtProperty *property)
     {
         // changing property editors triggers signals which cause the component to be updated in the game.
         // ignore these signals while initially creating the property editors
         if(_ignorePropertyChanges) return;
 
-        QtProperty* changedComponent = findComponentProperty(_editor, property);
+        QtProperty* changedComponent = componentProperty(property);
         Q_ASSERT(changedComponent);
-        QtProperty* changedProp = nullptr;
-        if(property == changedComponent)
+
+        // find the component field containing the changed property
+        QtProperty* changedProp = property;
+        while(changedProp != changedComponent && _parents.value(changedProp) != changedComponent)
         {
-            changedProp = changedComponent;
+            changedProp = _parents.value(changedProp);
         }
-        else
+
+        // the edited value now is the same for all displayed entities
+        _variantManager->setAttribute(property, "mixed", false);
+
+        if(_entityIds.size() > 1)
         {
-            foreach(auto prop, changedComponent->subProperties())
+            if(property == changedProp)
             {
-                if(findSubProperty(prop, property))
-                {
-                    changedProp = prop;
-                }
+                // whole field was edited, assign it to all entities
+                QVariantMap prop;
+                prop[changedProp->propertyName()] = _variantManager->value(changedProp);
+                QVariantMap components;
+                components[changedComponent->propertyName()] = prop;
+                emit entitiesDataChanged(_entityIds, components);
+                return;
             }
+
+            // only patch the edited value, other values of the field may differ between entities
+            QtEntity::PropertyPath path;
+            if(propertyPath(property, changedComponent, path))
+            {
+                emit entitiesFieldChanged(_entityIds, changedComponent->propertyName(),
+                                          path.toString(), _variantManager->value(property));
+            }
+            return;
+        }
+
+        if(_fieldPatchesEnabled)
+        {
+            QtEntity::PropertyPath path;
+            if(propertyPath(property, changedComponent, path))
+            {
+                emit entityFieldChanged(_entityId, changedComponent->propertyName(),
+                                        path.toString(), _variantManager->value(property));
+            }
+            return;
         }
-        
-        Q_ASSERT(changedProp);
 
         QVariantMap prop;
         prop[changedProp->propertyName()] =  _variantManager->value(changedProp);
@@ -467,7 +1121,22 @@ namespace QtEntityUtils
     {
         foreach(auto entry, entries)
         {
-            bool expanded = _variantManager->attributeValue(entry->property(), "expanded").toBool();
+            QtVariantProperty* prop = static_cast<QtVariantProperty*>(entry->property());
+            bool expanded = _variantManager->attributeValue(prop, "expanded").toBool();
+            if(prop->propertyType() == VariantManager::listId() && !_shownLists.contains(prop))
+            {
+                if(expanded)
+                {
+                    // handles entries of the page
+                    showListPage(prop, _variantManager->listOffset(prop));
+                }
+                else
+                {
+                    _editor->setChildIndicatorShown(entry, !_variantManager->value(prop).value<ItemList>().isEmpty());
+                    _editor->setExpanded(entry, false);
+                }
+                continue;
+            }
             if(!expanded)
             {
                 _editor->setExpanded(entry, false);
@@ -476,7 +1145,71 @@ namespace QtEntityUtils
         }        
     }
 
-    void setAllExpanded(QtTreePropertyBrowser* editor, QtVariantPropertyManager* variantManager, QList<QtBrowserItem *> entries, bool expanded)
+
+    void EntityEditor::showPendingListPages()
+    {
+        QSet<QtProperty*> pending;
+        pending.swap(_pendingLists);
+        foreach(QtProperty* prop, pending)
+        {
+            if(_shownLists.contains(prop)) continue;
+            foreach(QtBrowserItem* item, _editor->items(prop))
+            {
+                if(_editor->isExpanded(item))
+                {
+                    showListPage(static_cast<QtVariantProperty*>(prop), _variantManager->listOffset(prop));
+                    break;
+                }
+            }
+        }
+    }
+
+
+    void EntityEditor::showListPage(QtVariantProperty* prop, int offset)
+    {
+        bool ignore = _ignorePropertyChanges;
+        _ignorePropertyChanges = true;
+
+        // take edited values of current page before removing it
+        ItemList items = _variantManager->value(prop).value<ItemList>();
+        foreach(QtProperty* sub, prop->subProperties())
+        {
+            prop->removeSubProperty(sub);
+            deletePropertyTree(sub);
+        }
+        _variantManager->setListItems(prop, items);
+
+        int pagesize = _variantManager->attributeValue(prop, "pagesize").toInt();
+        offset = qBound(0, offset, qMax(0, items.size() - 1));
+        offset -= offset % pagesize;
+        _variantManager->setListOffset(prop, offset);
+
+        QList<QtProperty*> created;
+        int end = qMin(items.size(), offset + pagesize);
+        for(int i = offset; i < end; ++i)
+        {
+            const Item& item = items[i];
+            QtVariantProperty* entry = this->addWidgetsRecursively(item._prototype, item._value,
+                                                                   listEntryAttributes(item._prototype));
+            if(entry)
+            {
+                entry->setAttribute("prototype", item._prototype);
+                created.push_back(entry);
+            }
+        }
+        _shownLists.insert(prop);
+
+        _editor->beginUpdate();
+        prop->insertSubProperties(created, nullptr);
+        foreach(QtBrowserItem* entry, _editor->items(prop))
+        {
+            collapseCollapsedEntries(entry->children());
+        }
+        _editor->endUpdate();
+        _ignorePropertyChanges = ignore;
+    }
+
+    void setAllExpanded(QtModelPropertyBrowser* editor, QtVariantPropertyManager* variantManager, QList<QtBrowserItem *> entries, bool expanded)
     {
         foreach(auto entry, entries)
         {
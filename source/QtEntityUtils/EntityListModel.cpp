@@ -0,0 +1,498 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <QtEntityUtils/EntityListModel>
+
+#include <QtEntity/EntityManager>
+#include <QtEntity/EntitySystem>
+#include <QtEntity/PropertyTable>
+#include <QTimer>
+#include <algorithm>
+
+namespace QtEntityUtils
+{
+    // when a batch removes more separate row ranges than this,
+    // the model is reset instead of emitting a signal per range
+    static const int MaxRemovedRanges = 64;
+
+
+    EntityListModel::EntityListModel(QtEntity::EntityManager* em, QObject* parent)
+        : QAbstractTableModel(parent)
+        , _em(em)
+        , _updateTimer(new QTimer(this))
+        , _componentFilterValid(true)
+        , _removedEntries(0)
+    {
+        _updateTimer->setSingleShot(true);
+        _updateTimer->setInterval(16);
+        connect(_updateTimer, &QTimer::timeout, this, &EntityListModel::flush);
+        refresh();
+    }
+
+
+    EntityListModel::~EntityListModel()
+    {
+    }
+
+
+    void EntityListModel::setNameField(const QString& componentName, const QString& fieldName)
+    {
+        _nameComponent = componentName;
+        _nameField = fieldName;
+    }
+
+
+    void EntityListModel::setUpdateInterval(int ms)
+    {
+        _updateTimer->setInterval(ms);
+    }
+
+
+    int EntityListModel::updateInterval() const
+    {
+        return _updateTimer->interval();
+    }
+
+
+    void EntityListModel::setComponentFilter(const QStringList& componentNames)
+    {
+        beginResetModel();
+        _componentFilter = componentNames;
+        _componentMask.clear();
+        _componentFilterValid = true;
+        foreach(const QString& name, componentNames)
+        {
+            QtEntity::EntitySystem* es = _em->system(name);
+            int bit = es ? systemBit(es) : -1;
+            if(bit == -1)
+            {
+                // no entity can have an unknown component
+                _componentFilterValid = false;
+            }
+            else
+            {
+                setSystemBit(_componentMask, bit);
+            }
+        }
+        rebuildRows();
+        endResetModel();
+    }
+
+
+    void EntityListModel::setNameFilter(const QString& name)
+    {
+        if(name == _nameFilter) return;
+        beginResetModel();
+        _nameFilter = name;
+        rebuildRows();
+        endResetModel();
+    }
+
+
+    QtEntity::EntityId EntityListModel::entityId(const QModelIndex& index) const
+    {
+        if(!index.isValid() || index.row() >= _rows.size()) return 0;
+        return _entries[_rows[index.row()]]._id;
+    }
+
+
+    QModelIndex EntityListModel::indexOf(QtEntity::EntityId id) const
+    {
+        int entry = _index.value(id, -1);
+        int row = (entry == -1) ? -1 : rowOf(entry);
+        return (row == -1) ? QModelIndex() : index(row, 0);
+    }
+
+
+    int EntityListModel::rowCount(const QModelIndex& parent) const
+    {
+        return parent.isValid() ? 0 : _rows.size();
+    }
+
+
+    int EntityListModel::columnCount(const QModelIndex& parent) const
+    {
+        return parent.isValid() ? 0 : ColumnCount;
+    }
+
+
+    QVariant EntityListModel::data(const QModelIndex& index, int role) const
+    {
+        if(!index.isValid() || index.row() >= _rows.size()) return QVariant();
+
+        const Entry& e = _entries[_rows[index.row()]];
+        if(role == EntityIdRole)
+        {
+            return e._id;
+        }
+        if(role != Qt::DisplayRole)
+        {
+            return QVariant();
+        }
+
+        switch(index.column())
+        {
+        case IdColumn:
+            return e._id;
+        case NameColumn:
+            return e._name;
+        case ComponentsColumn:
+        {
+            QStringList names;
+            for(int bit = 0; bit < _componentNames.size(); ++bit)
+            {
+                if(bit < e._components.size() && e._components.testBit(bit))
+                {
+                    names.push_back(_componentNames[bit]);
+                }
+            }
+            return names.join(", ");
+        }
+        default:
+            return QVariant();
+        }
+    }
+
+
+    QVariant EntityListModel::headerData(int section, Qt::Orientation orientation, int role) const
+    {
+        if(orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        {
+            return QAbstractTableModel::headerData(section, orientation, role);
+        }
+        switch(section)
+        {
+        case IdColumn: return tr("ID");
+        case NameColumn: return tr("Name");
+        case ComponentsColumn: return tr("Components");
+        default: return QVariant();
+        }
+    }
+
+
+    void EntityListModel::entityChanged(QtEntity::EntityId id)
+    {
+        _pending.insert(id);
+        if(!_updateTimer->isActive())
+        {
+            _updateTimer->start();
+        }
+    }
+
+
+    void EntityListModel::flush()
+    {
+        _updateTimer->stop();
+        if(_pending.isEmpty()) return;
+
+        // sort scheduled entities into removed, changed and added ones
+        QtEntity::EntitySystem* names = nameSystem();
+        QVector<int> removed;
+        QVector<QPair<int, Entry> > changed;
+        QVector<Entry> added;
+        foreach(QtEntity::EntityId id, _pending)
+        {
+            Entry e = readEntry(id, names);
+            int entry = _index.value(id, -1);
+            if(entry == -1)
+            {
+                if(e._components.count(true) != 0) added.push_back(e);
+            }
+            else if(e._components.count(true) == 0)
+            {
+                removed.push_back(entry);
+            }
+            else
+            {
+                changed.push_back(qMakePair(entry, e));
+            }
+        }
+        _pending.clear();
+        std::sort(added.begin(), added.end(), [](const Entry& a, const Entry& b) { return a._id < b._id; });
+
+        // entities becoming visible or hidden in the middle of the list cause a reset
+        bool reset = false;
+        for(auto i = changed.begin(); i != changed.end(); ++i)
+        {
+            if(accepts(_entries[i->first]) != accepts(i->second))
+            {
+                reset = true;
+                break;
+            }
+        }
+
+        QVector<int> removedRows;
+        foreach(int entry, removed)
+        {
+            int row = rowOf(entry);
+            if(row != -1) removedRows.push_back(row);
+        }
+        std::sort(removedRows.begin(), removedRows.end());
+        int ranges = 0;
+        for(int i = 0; i < removedRows.size(); ++i)
+        {
+            if(i == 0 || removedRows[i] != removedRows[i - 1] + 1) ++ranges;
+        }
+        if(ranges > MaxRemovedRanges)
+        {
+            reset = true;
+        }
+
+        if(reset)
+        {
+            beginResetModel();
+        }
+        else
+        {
+            // remove ranges of consecutive rows, last range first
+            int last = removedRows.size() - 1;
+            while(last >= 0)
+            {
+                int first = last;
+                while(first > 0 && removedRows[first - 1] == removedRows[first] - 1)
+                {
+                    --first;
+                }
+                beginRemoveRows(QModelIndex(), removedRows[first], removedRows[last]);
+                _rows.remove(removedRows[first], last - first + 1);
+                endRemoveRows();
+                last = first - 1;
+            }
+        }
+
+        foreach(int entry, removed)
+        {
+            _index.remove(_entries[entry]._id);
+            _entries[entry]._id = 0;
+            _entries[entry]._name.clear();
+            ++_removedEntries;
+        }
+
+        int firstChanged = _rows.size();
+        int lastChanged = -1;
+        for(auto i = changed.begin(); i != changed.end(); ++i)
+        {
+            _entries[i->first] = i->second;
+            int row = reset ? -1 : rowOf(i->first);
+            if(row != -1)
+            {
+                firstChanged = qMin(firstChanged, row);
+                lastChanged = qMax(lastChanged, row);
+            }
+        }
+
+        int firstAdded = _entries.size();
+        foreach(const Entry& e, added)
+        {
+            _index.insert(e._id, _entries.size());
+            _entries.push_back(e);
+        }
+
+        if(reset)
+        {
+            rebuildRows();
+            endResetModel();
+        }
+        else
+        {
+            if(lastChanged != -1)
+            {
+                emit dataChanged(index(firstChanged, 0), index(lastChanged, ColumnCount - 1));
+            }
+
+            // added entities are appended after the existing rows
+            QVector<int> addedRows;
+            for(int i = firstAdded; i < _entries.size(); ++i)
+            {
+                if(accepts(_entries[i])) addedRows.push_back(i);
+            }
+            if(!addedRows.isEmpty())
+            {
+                beginInsertRows(QModelIndex(), _rows.size(), _rows.size() + addedRows.size() - 1);
+                _rows += addedRows;
+                endInsertRows();
+            }
+        }
+        compact();
+    }
+
+
+    void EntityListModel::refresh()
+    {
+        beginResetModel();
+        _entries.clear();
+        _index.clear();
+        _rows.clear();
+        _pending.clear();
+        _removedEntries = 0;
+
+        // collect component sets by iterating all systems once
+        QHash<QtEntity::EntityId, QBitArray> components;
+        for(auto i = _em->begin(); i != _em->end(); ++i)
+        {
+            QtEntity::EntitySystem* es = i->second;
+            int bit = systemBit(es);
+            QtEntity::PIterator end = es->pend();
+            for(QtEntity::PIterator c = es->pbegin(); c != end; ++c)
+            {
+                // skip systems whose iterators do not provide entity ids
+                if(c.id() == 0) break;
+                setSystemBit(components[c.id()], bit);
+            }
+        }
+
+        QList<QtEntity::EntityId> ids = components.keys();
+        std::sort(ids.begin(), ids.end());
+
+        QtEntity::EntitySystem* names = nameSystem();
+        _entries.reserve(ids.size());
+        _index.reserve(ids.size());
+        foreach(QtEntity::EntityId id, ids)
+        {
+            Entry e;
+            e._id = id;
+            e._components = components[id];
+            e._name = readName(id, names);
+            _index.insert(id, _entries.size());
+            _entries.push_back(e);
+        }
+
+        rebuildRows();
+        endResetModel();
+    }
+
+
+    QtEntity::EntitySystem* EntityListModel::nameSystem() const
+    {
+        return _nameComponent.isEmpty() ? nullptr : _em->system(_nameComponent);
+    }
+
+
+    EntityListModel::Entry EntityListModel::readEntry(QtEntity::EntityId id, QtEntity::EntitySystem* names)
+    {
+        Entry e;
+        e._id = id;
+        for(auto i = _em->begin(); i != _em->end(); ++i)
+        {
+            QtEntity::EntitySystem* es = i->second;
+            if(es->component(id) == nullptr) continue;
+            setSystemBit(e._components, systemBit(es));
+        }
+        if(e._components.count(true) != 0)
+        {
+            e._name = readName(id, names);
+        }
+        return e;
+    }
+
+
+    QString EntityListModel::readName(QtEntity::EntityId id, QtEntity::EntitySystem* names) const
+    {
+        if(names == nullptr) return QString();
+        void* c = names->component(id);
+        if(c == nullptr) return QString();
+
+        // read single property if system supports it, else convert whole component
+        const QtEntity::PropertyTable* table = names->propertyTable();
+        int index = table ? table->indexOf(_nameField) : -1;
+        if(index != -1)
+        {
+            return table->read(index, c).toString();
+        }
+        return names->toVariantMap(id).value(_nameField).toString();
+    }
+
+
+    void EntityListModel::setSystemBit(QBitArray& bits, int bit)
+    {
+        if(bits.size() <= bit) bits.resize(bit + 1);
+        bits.setBit(bit);
+    }
+
+
+    int EntityListModel::systemBit(QtEntity::EntitySystem* es)
+    {
+        auto i = _systemBits.find(es->componentType());
+        if(i != _systemBits.end()) return i.value();
+
+        int bit = _componentNames.size();
+        _componentNames.push_back(es->componentName());
+        _systemBits.insert(es->componentType(), bit);
+        return bit;
+    }
+
+
+    bool EntityListModel::accepts(const Entry& e) const
+    {
+        if(!_componentFilterValid) return false;
+        for(int bit = 0; bit < _componentMask.size(); ++bit)
+        {
+            if(_componentMask.testBit(bit) && (bit >= e._components.size() || !e._components.testBit(bit)))
+            {
+                return false;
+            }
+        }
+        return _nameFilter.isEmpty() || e._name.contains(_nameFilter, Qt::CaseInsensitive);
+    }
+
+
+    int EntityListModel::rowOf(int entry) const
+    {
+        auto i = std::lower_bound(_rows.begin(), _rows.end(), entry);
+        return (i != _rows.end() && *i == entry) ? int(i - _rows.begin()) : -1;
+    }
+
+
+    void EntityListModel::rebuildRows()
+    {
+        _rows.clear();
+        for(int i = 0; i < _entries.size(); ++i)
+        {
+            if(_entries[i]._id != 0 && accepts(_entries[i]))
+            {
+                _rows.push_back(i);
+            }
+        }
+    }
+
+
+    void EntityListModel::compact()
+    {
+        if(_removedEntries < 1024 || _removedEntries * 2 < _entries.size()) return;
+
+        // rows stay the same, only their entry indices change
+        QVector<int> remap(_entries.size(), -1);
+        QVector<Entry> entries;
+        entries.reserve(_entries.size() - _removedEntries);
+        for(int i = 0; i < _entries.size(); ++i)
+        {
+            if(_entries[i]._id == 0) continue;
+            remap[i] = entries.size();
+            entries.push_back(_entries[i]);
+        }
+        for(auto i = _rows.begin(); i != _rows.end(); ++i)
+        {
+            *i = remap[*i];
+        }
+        for(auto i = _index.begin(); i != _index.end(); ++i)
+        {
+            i.value() = remap[i.value()];
+        }
+        _entries.swap(entries);
+        _removedEntries = 0;
+    }
+}
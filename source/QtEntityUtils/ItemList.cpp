@@ -16,6 +16,8 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <QtEntityUtils/ItemList>
 
+#include <QtEntity/PropertyPath>
+
 namespace QtEntityUtils
 {
 
@@ -45,5 +47,57 @@ namespace QtEntityUtils
     {
     }
 
+
+    QDataStream& operator<<(QDataStream& out, const Item& item)
+    {
+        out << item._prototype << item._value;
+        return out;
+    }
+
+
+    QDataStream& operator>>(QDataStream& in, Item& item)
+    {
+        in >> item._prototype >> item._value;
+        return in;
+    }
+
+
+    bool setValueAtPath(QVariant& target, const QtEntity::PropertyPath& path, int from, const QVariant& value)
+    {
+        if(from == path.size())
+        {
+            target = value;
+            return true;
+        }
+
+        const QtEntity::PropertyPath::Segment& seg = path.at(from);
+        if(seg.isIndex())
+        {
+            if(target.userType() == qMetaTypeId<ItemList>())
+            {
+                ItemList items = target.value<ItemList>();
+                if(seg._index >= items.size()) return false;
+                if(!setValueAtPath(items[seg._index]._value, path, from + 1, value)) return false;
+                target = QVariant::fromValue(items);
+                return true;
+            }
+            if(target.type() == QVariant::List)
+            {
+                QVariantList items = target.toList();
+                if(seg._index >= items.size()) return false;
+                if(!setValueAtPath(items[seg._index], path, from + 1, value)) return false;
+                target = items;
+                return true;
+            }
+            return false;
+        }
+
+        if(target.type() != QVariant::Map) return false;
+        QVariantMap m = target.toMap();
+        if(!setValueAtPath(m[seg._name], path, from + 1, value)) return false;
+        target = m;
+        return true;
+    }
+
  
 }
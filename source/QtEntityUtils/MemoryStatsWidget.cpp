@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <QtEntityUtils/MemoryStatsWidget>
+
+#include <QtEntity/EntityManager>
+#include <QtEntity/EntitySystem>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+namespace QtEntityUtils
+{
+    namespace
+    {
+        // table item that sorts by the number stored in Qt::UserRole instead of by display text
+        class NumberItem : public QTableWidgetItem
+        {
+        public:
+            NumberItem(const QString& text, double value)
+                : QTableWidgetItem(text)
+            {
+                setData(Qt::UserRole, value);
+                setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            }
+
+            bool operator<(const QTableWidgetItem& other) const override
+            {
+                return data(Qt::UserRole).toDouble() < other.data(Qt::UserRole).toDouble();
+            }
+        };
+    }
+
+
+    static QString formatBytes(size_t bytes)
+    {
+        if(bytes < 1024) return QString("%1 B").arg(bytes);
+        if(bytes < 1024 * 1024) return QString("%1 KB").arg(double(bytes) / 1024.0, 0, 'f', 1);
+        return QString("%1 MB").arg(double(bytes) / (1024.0 * 1024.0), 0, 'f', 1);
+    }
+
+
+    static QString formatPercent(double fraction)
+    {
+        return QString("%1 %").arg(fraction * 100.0, 0, 'f', 1);
+    }
+
+
+    MemoryStatsWidget::MemoryStatsWidget(QtEntity::EntityManager* em, QWidget* parent)
+        : QWidget(parent)
+        , _em(em)
+        , _table(new QTableWidget(this))
+        , _total(new QLabel(this))
+        , _refreshTimer(new QTimer(this))
+    {
+        _table->setColumnCount(ColumnCount);
+        _table->setHorizontalHeaderLabels(QStringList() << tr("System") << tr("Count") << tr("Live")
+                                          << tr("Reserved") << tr("Index") << tr("Owned")
+                                          << tr("Total") << tr("Fragmentation"));
+        _table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        _table->setSelectionBehavior(QAbstractItemView::SelectRows);
+        _table->verticalHeader()->hide();
+        _table->horizontalHeader()->setSectionResizeMode(SystemColumn, QHeaderView::Stretch);
+        _table->horizontalHeader()->setSortIndicator(TotalColumn, Qt::DescendingOrder);
+        _table->setSortingEnabled(true);
+
+        QVBoxLayout* layout = new QVBoxLayout(this);
+        layout->setContentsMargins(0, 0, 0, 0);
+        layout->addWidget(_table);
+        layout->addWidget(_total);
+
+        connect(_refreshTimer, &QTimer::timeout, this, &MemoryStatsWidget::refresh);
+        refresh();
+    }
+
+
+    void MemoryStatsWidget::setRefreshInterval(int ms)
+    {
+        if(ms > 0)
+        {
+            _refreshTimer->start(ms);
+        }
+        else
+        {
+            _refreshTimer->stop();
+        }
+    }
+
+
+    int MemoryStatsWidget::refreshInterval() const
+    {
+        return _refreshTimer->isActive() ? _refreshTimer->interval() : 0;
+    }
+
+
+    void MemoryStatsWidget::refresh()
+    {
+        // rows would move while being filled when sorting is enabled
+        _table->setSortingEnabled(false);
+        _table->setRowCount(0);
+
+        for(auto i = _em->begin(); i != _em->end(); ++i)
+        {
+            QtEntity::MemoryStats s = i->second->memoryStats();
+            int row = _table->rowCount();
+            _table->insertRow(row);
+            _table->setItem(row, SystemColumn,   new QTableWidgetItem(i->second->componentName()));
+            _table->setItem(row, CountColumn,    new NumberItem(QString::number(s._count), s._count));
+            _table->setItem(row, LiveColumn,     new NumberItem(formatBytes(s._liveBytes), s._liveBytes));
+            _table->setItem(row, ReservedColumn, new NumberItem(formatBytes(s._reservedBytes), s._reservedBytes));
+            _table->setItem(row, IndexColumn,    new NumberItem(formatBytes(s._indexBytes), s._indexBytes));
+            _table->setItem(row, OwnedColumn,    new NumberItem(formatBytes(s._ownedBytes), s._ownedBytes));
+            _table->setItem(row, TotalColumn,    new NumberItem(formatBytes(s.totalBytes()), s.totalBytes()));
+            _table->setItem(row, FragmentationColumn, new NumberItem(formatPercent(s.fragmentation()), s.fragmentation()));
+        }
+
+        _table->setSortingEnabled(true);
+
+        QtEntity::MemoryStats total = _em->memoryStats();
+        _total->setText(tr("%1 components in %2, %3 index, %4 owned, %5 fragmentation")
+                        .arg(total._count)
+                        .arg(formatBytes(total._reservedBytes))
+                        .arg(formatBytes(total._indexBytes))
+                        .arg(formatBytes(total._ownedBytes))
+                        .arg(formatPercent(total.fragmentation())));
+    }
+}
@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <QtEntityUtils/PrefabLibrary>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace QtEntityUtils
+{
+
+    // identifies binary prefab cache files
+    static const quint32 CACHE_MAGIC = 0x51455046; // "QEPF"
+    static const quint32 CACHE_VERSION = 1;
+
+
+    PrefabLibrary::PrefabLibrary()
+    {
+    }
+
+
+    PrefabLibrary::~PrefabLibrary()
+    {
+    }
+
+
+    int PrefabLibrary::indexDirectory(const QString& dir)
+    {
+        QDir root(dir);
+        int found = 0;
+        QDirIterator it(root.absolutePath(), QStringList() << "*.json", QDir::Files, QDirIterator::Subdirectories);
+        while(it.hasNext())
+        {
+            QString path = it.next();
+            QString relative = root.relativeFilePath(path);
+            QString name = relative.left(relative.length() - QString(".json").length());
+            _files[name] = path;
+            ++found;
+        }
+        return found;
+    }
+
+
+    bool PrefabLibrary::load(const QString& name, QVariantMap& components, QStringList& parameters) const
+    {
+        auto i = _files.find(name);
+        if(i == _files.end())
+        {
+            return false;
+        }
+
+        QFile file(i.value());
+        if(!file.open(QIODevice::ReadOnly))
+        {
+            qDebug() << "Could not open prefab file " << i.value();
+            return false;
+        }
+        QByteArray contents = file.readAll();
+
+        QString cachePath;
+        if(!_cacheDirectory.isEmpty())
+        {
+            QByteArray hash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1).toHex();
+            cachePath = QDir(_cacheDirectory).filePath(QString::fromLatin1(hash) + ".prefab");
+            if(readCache(cachePath, components, parameters))
+            {
+                return true;
+            }
+        }
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(contents, &error);
+        if(error.error != QJsonParseError::NoError || !doc.isObject())
+        {
+            qDebug() << "Could not parse prefab file " << i.value() << ":" << error.errorString();
+            return false;
+        }
+
+        QJsonObject obj = doc.object();
+        components = obj.value("components").toObject().toVariantMap();
+        parameters = obj.value("parameters").toVariant().toStringList();
+
+        if(!cachePath.isEmpty())
+        {
+            writeCache(cachePath, components, parameters);
+        }
+        return true;
+    }
+
+
+    bool PrefabLibrary::readCache(const QString& cachePath, QVariantMap& components, QStringList& parameters) const
+    {
+        QFile file(cachePath);
+        if(!file.open(QIODevice::ReadOnly))
+        {
+            return false;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint32 magic, version;
+        stream >> magic >> version;
+        if(magic != CACHE_MAGIC || version != CACHE_VERSION)
+        {
+            return false;
+        }
+        stream >> components >> parameters;
+        return stream.status() == QDataStream::Ok;
+    }
+
+
+    void PrefabLibrary::writeCache(const QString& cachePath, const QVariantMap& components, const QStringList& parameters) const
+    {
+        QDir().mkpath(_cacheDirectory);
+        QFile file(cachePath);
+        if(!file.open(QIODevice::WriteOnly))
+        {
+            qDebug() << "Could not write prefab cache file " << cachePath;
+            return;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << CACHE_MAGIC << CACHE_VERSION << components << parameters;
+    }
+}
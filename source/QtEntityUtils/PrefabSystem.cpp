@@ -16,6 +16,7 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <QtEntityUtils/PrefabSystem>
 
+#include <QtEntityUtils/PrefabLibrary>
 #include <QtEntity/EntityManager>
 #include <QMetaProperty>
 #include <QDebug>
@@ -29,7 +30,29 @@ namespace QtEntityUtils
         , _components(components)
         , _parameters(parameters)
     {
+        updateComponentBags();
+    }
+
+
+    void Prefab::setComponents(const QVariantMap& v)
+    {
+        _components = v;
+        updateComponentBags();
+    }
 
+
+    void Prefab::updateComponentBags()
+    {
+        _componentBags.clear();
+        for(auto i = _components.begin(); i != _components.end(); ++i)
+        {
+            ComponentBag b;
+            b._componentName = i.key();
+            b._componentType = 0;
+            b._values = i.value().toMap();
+            b._properties = QtEntity::PropertyBag(b._values);
+            _componentBags.push_back(b);
+        }
     }
 
 
@@ -45,6 +68,7 @@ namespace QtEntityUtils
     
     PrefabSystem::PrefabSystem(QtEntity::EntityManager* em)
         : BaseClass(em)
+        , _library(nullptr)
     {
     }
 
@@ -82,6 +106,7 @@ namespace QtEntityUtils
             current.remove(param);
         }
         prefab->_components[component] = current;
+        prefab->updateComponentBags();
 
 
         if(updateInstances)
@@ -207,36 +232,82 @@ namespace QtEntityUtils
 
     void PrefabSystem::createPrefabComponents(QtEntity::EntityId id, Prefab* prefab) const
     {
-        const QVariantMap& c = prefab->components();
+        const QVector<Prefab::ComponentBag>& c = prefab->componentBags();
         for(auto i = c.begin(); i != c.end(); ++i)
         {
-            const QString& classname = i.key();
-            const QVariant& var = i.value();
-            EntitySystem* es = entityManager()->system(classname);
-            if(es)
+            EntitySystem* es;
+            if(i->_componentType == 0)
             {
-                es->createComponent(id, var.value<QVariantMap>());
+                // system may have been registered after the prefab was loaded
+                es = entityManager()->system(i->_componentName);
+                if(es == nullptr)
+                {
+                    continue;
+                }
+                i->_componentType = es->componentType();
+            }
+            else
+            {
+                es = entityManager()->system(i->_componentType);
+                if(es == nullptr)
+                {
+                    continue;
+                }
+            }
+            if(es->propertyTable() != nullptr)
+            {
+                es->createComponentFromBag(id, i->_properties);
+            }
+            else
+            {
+                es->createComponent(id, i->_values);
             }
         }
     }
 
 
+    QSharedPointer<Prefab> PrefabSystem::findOrLoadPrefab(const QString& path)
+    {
+        Prefabs::const_iterator i = _prefabs.find(path);
+        if(i != _prefabs.end())
+        {
+            return i.value();
+        }
+
+        QVariantMap components;
+        QStringList parameters;
+        if(_library == nullptr || !_library->load(path, components, parameters))
+        {
+            return QSharedPointer<Prefab>();
+        }
+        addPrefab(path, components, parameters);
+        return _prefabs[path];
+    }
+
+
     void* PrefabSystem::createComponent(QtEntity::EntityId id, const QVariantMap& properties)
     {
+        QTENTITY_PROFILE_ZONE("PrefabSystem::createComponent");
         QString path = properties["path"].toString();
-        Prefabs::const_iterator i = _prefabs.find(path);
-        if(i == _prefabs.end())
+        QSharedPointer<Prefab> prefab = findOrLoadPrefab(path);
+        if(prefab.isNull())
         {
             return nullptr;
         }
         
         void* o = SimpleEntitySystem::createComponent(id, properties);
-        static_cast<PrefabInstance*>(o)->_prefab = *i;
-        createPrefabComponents(id, i.value().data());        
+        static_cast<PrefabInstance*>(o)->_prefab = prefab;
+        createPrefabComponents(id, prefab.data());        
         return o;
     }
 
 
+    void* PrefabSystem::createComponentFromBag(QtEntity::EntityId id, const QtEntity::PropertyBag& properties)
+    {
+        return createComponent(id, properties.toVariantMap());
+    }
+
+
     const Prefab* PrefabSystem::prefab(const QString& name) const
     {
         Prefabs::const_iterator i = _prefabs.find(name);
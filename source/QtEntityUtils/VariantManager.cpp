@@ -47,6 +47,28 @@ namespace QtEntityUtils
     }
 
 
+    void VariantManager::setListItems(QtProperty* property, const ItemList& items)
+    {
+        if(!_listValues.contains(property)) return;
+        _listValues[property].items = items;
+        emit propertyChanged(property);
+    }
+
+
+    int VariantManager::listOffset(const QtProperty* property) const
+    {
+        return _listValues.value(property).offset;
+    }
+
+
+    void VariantManager::setListOffset(QtProperty* property, int offset)
+    {
+        if(!_listValues.contains(property)) return;
+        _listValues[property].offset = qMax(0, offset);
+        emit propertyChanged(property);
+    }
+
+
     bool VariantManager::isPropertyTypeSupported(int propertyType) const
     {
         if (propertyType == filePathTypeId() ||
@@ -86,11 +108,13 @@ namespace QtEntityUtils
         }
         if(propertyType(property) == listId())
         {
+            // entries of shown page may have been edited, take them from sub properties
+            const ListData& data = _listValues[property];
+            ItemList ret = data.items;
             QList<QtProperty *> subs = property->subProperties();
-            ItemList ret;
-            for(auto i = subs.begin(); i != subs.end(); ++i)
+            for(int i = 0; i < subs.size() && data.offset + i < ret.size(); ++i)
             {
-                ret.push_back(Item(attributeValue(*i, "prototype").toString(), value(*i)));
+                ret[data.offset + i] = Item(attributeValue(subs[i], "prototype").toString(), value(subs[i]));
             }
             return QVariant::fromValue(ret);
         }
@@ -114,10 +138,12 @@ namespace QtEntityUtils
         {            
             attr << QLatin1String("prototypes");
             attr << QLatin1String("maxentries");
+            attr << QLatin1String("pagesize");
         }
 
         // available for all properties:
         attr << QLatin1String("prototype");
+        attr << QLatin1String("mixed");
         return attr;
     }
 
@@ -126,6 +152,8 @@ namespace QtEntityUtils
     {
         if (attribute == QLatin1String("prototype"))
            return QVariant::String;
+        if (attribute == QLatin1String("mixed"))
+           return QVariant::Bool;
 
         if (propertyType == filePathTypeId())
         {
@@ -140,6 +168,8 @@ namespace QtEntityUtils
                 return QVariant::StringList;
             if (attribute == QLatin1String("maxentries"))
                 return QVariant::Int;
+            if (attribute == QLatin1String("pagesize"))
+                return QVariant::Int;
             return 0;
         }
         return QtVariantPropertyManager::attributeType(propertyType, attribute);
@@ -148,7 +178,10 @@ namespace QtEntityUtils
 
     QVariant VariantManager::attributeValue(const QtProperty *property, const QString &attribute) const
     {        
-
+        if (attribute == QLatin1String("mixed"))
+        {
+            return _mixedValues.contains(property);
+        }
         if (_filePathValues.contains(property))
         {
             if (attribute == QLatin1String("filter"))
@@ -167,6 +200,10 @@ namespace QtEntityUtils
         {
             return _maxentriesValues[property];
         }
+        if (_pagesizeValues.contains(property) && attribute == QLatin1String("pagesize"))
+        {
+            return _pagesizeValues[property];
+        }
         if (_orderValues.contains(property) && attribute == QLatin1String("order"))
         {
             return _orderValues[property];
@@ -182,10 +219,25 @@ namespace QtEntityUtils
 
     QString VariantManager::valueText(const QtProperty *property) const
     {
-        if (_filePathValues.contains(property))
+        if (_mixedValues.contains(property))
+        {
+            return QLatin1String("<multiple values>");
+        }
+        else if (_filePathValues.contains(property))
         {
             return _filePathValues[property].value;
         }        
+        else if (_listValues.contains(property))
+        {
+            const ListData& data = _listValues[property];
+            int pagesize = _pagesizeValues.value(property);
+            if(data.items.size() <= pagesize && data.offset == 0)
+            {
+                return QString();
+            }
+            int last = qMin(data.offset + pagesize, data.items.size());
+            return QString("%1-%2 of %3").arg(data.offset + 1).arg(last).arg(data.items.size());
+        }
         else
         {
             return QtVariantPropertyManager::valueText(property);
@@ -225,7 +277,18 @@ namespace QtEntityUtils
     void VariantManager::setAttribute(QtProperty *property,
                     const QString &attribute, const QVariant &val)
     {
-        
+        if(attribute == QLatin1String("mixed"))
+        {
+            if(val.toBool() == _mixedValues.contains(property))
+                return;
+            if(val.toBool())
+                _mixedValues.insert(property);
+            else
+                _mixedValues.remove(property);
+            emit propertyChanged(property);
+            return;
+        }
+
         if (_filePathValues.contains(property))
         {
             if (attribute == QLatin1String("filter")) {
@@ -260,6 +323,13 @@ namespace QtEntityUtils
             return;
         }
 
+        if(_pagesizeValues.contains(property) && attribute == QLatin1String("pagesize"))
+        {
+            _pagesizeValues[property] = qMax(1, val.toInt());
+            emit propertyChanged(property);
+            return;
+        }
+
         if(_orderValues.contains(property) && attribute == QLatin1String("order"))
         {
             _orderValues[property] = val.toInt();
@@ -288,6 +358,8 @@ namespace QtEntityUtils
         {
             _prototypesValues[property] = QStringList();
             _maxentriesValues[property] = INT_MAX;
+            _pagesizeValues[property] = 100;
+            _listValues[property] = ListData();
         }
         QtVariantPropertyManager::initializeProperty(property);
     }
@@ -297,8 +369,11 @@ namespace QtEntityUtils
     {
         _orderValues.remove(property);
         _expandedValues.remove(property);
+        _mixedValues.remove(property);
         _filePathValues.remove(property);
         _maxentriesValues.remove(property);
+        _pagesizeValues.remove(property);
+        _listValues.remove(property);
         _prototypeValues.remove(property);
         _prototypesValues.remove(property);
         QtVariantPropertyManager::uninitializeProperty(property);
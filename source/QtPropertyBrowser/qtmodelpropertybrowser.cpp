@@ -0,0 +1,640 @@
+/*
+Copyright (c) 2013 Martin Scheffler
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated 
+documentation files (the "Software"), to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "qtmodelpropertybrowser.h"
+#include <QtCore/QAbstractItemModel>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtGui/QFont>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QStyledItemDelegate>
+#include <QtWidgets/QTreeView>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Item model over the browser items of a QtModelPropertyBrowser.
+    The model keeps its own child lists, so rows are announced to the
+    view before they are inserted or removed.
+*/
+class QtPropertyBrowserModel : public QAbstractItemModel
+{
+public:
+    QtPropertyBrowserModel(QObject *parent)
+        : QAbstractItemModel(parent), m_markPropertiesWithoutValue(false) {}
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
+    QModelIndex parent(const QModelIndex &index) const;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role) const;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const;
+    Qt::ItemFlags flags(const QModelIndex &index) const;
+
+    QtBrowserItem *browserItem(const QModelIndex &index) const
+        { return index.isValid() ? static_cast<QtBrowserItem *>(index.internalPointer()) : 0; }
+    QModelIndex indexOf(QtBrowserItem *item, int column = 0) const;
+
+    void insertItems(const QList<QtBrowserItem *> &items, QtBrowserItem *afterItem);
+    void removeItem(QtBrowserItem *item);
+    void changeItem(QtBrowserItem *item);
+
+    void setChildIndicatorShown(QtBrowserItem *item, bool shown);
+    void setMarkPropertiesWithoutValue(bool mark);
+    bool markPropertiesWithoutValue() const { return m_markPropertiesWithoutValue; }
+
+private:
+    int row(QtBrowserItem *item) const;
+
+    // shown children by parent item, 0 for top level items
+    QHash<QtBrowserItem *, QList<QtBrowserItem *> > m_children;
+    // last known row of items. Rows are mostly appended, so this avoids searching siblings
+    mutable QHash<QtBrowserItem *, int> m_rowHints;
+    // items showing an expand indicator without having children
+    QSet<QtBrowserItem *> m_childIndicators;
+    bool m_markPropertiesWithoutValue;
+};
+
+int QtPropertyBrowserModel::row(QtBrowserItem *item) const
+{
+    const QList<QtBrowserItem *> siblings = m_children.value(item->parent());
+    const int hint = m_rowHints.value(item, -1);
+    if (hint >= 0 && hint < siblings.size() && siblings.at(hint) == item)
+        return hint;
+    const int r = siblings.indexOf(item);
+    m_rowHints[item] = r;
+    return r;
+}
+
+QModelIndex QtPropertyBrowserModel::indexOf(QtBrowserItem *item, int column) const
+{
+    if (!item)
+        return QModelIndex();
+    const int r = row(item);
+    if (r < 0)
+        return QModelIndex();
+    return createIndex(r, column, item);
+}
+
+QModelIndex QtPropertyBrowserModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (column < 0 || column > 1 || (parent.isValid() && parent.column() != 0))
+        return QModelIndex();
+    const QList<QtBrowserItem *> children = m_children.value(browserItem(parent));
+    if (row < 0 || row >= children.size())
+        return QModelIndex();
+    QtBrowserItem *item = children.at(row);
+    m_rowHints[item] = row;
+    return createIndex(row, column, item);
+}
+
+QModelIndex QtPropertyBrowserModel::parent(const QModelIndex &index) const
+{
+    QtBrowserItem *item = browserItem(index);
+    if (!item)
+        return QModelIndex();
+    return indexOf(item->parent());
+}
+
+int QtPropertyBrowserModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+        return 0;
+    return m_children.value(browserItem(parent)).size();
+}
+
+int QtPropertyBrowserModel::columnCount(const QModelIndex &) const
+{
+    return 2;
+}
+
+bool QtPropertyBrowserModel::hasChildren(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+        return false;
+    if (rowCount(parent) > 0)
+        return true;
+    QtBrowserItem *item = browserItem(parent);
+    return item && m_childIndicators.contains(item);
+}
+
+QVariant QtPropertyBrowserModel::data(const QModelIndex &index, int role) const
+{
+    QtBrowserItem *item = browserItem(index);
+    if (!item)
+        return QVariant();
+
+    QtProperty *property = item->property();
+    const bool valueColumn = index.column() == 1;
+    switch (role) {
+    case Qt::DisplayRole:
+        if (!valueColumn)
+            return property->propertyName();
+        if (property->hasValue())
+            return property->valueText();
+        break;
+    case Qt::DecorationRole:
+        if (valueColumn && property->hasValue())
+            return property->valueIcon();
+        break;
+    case Qt::ToolTipRole:
+        if (!valueColumn)
+            return property->propertyName();
+        if (property->hasValue())
+            return property->toolTip().isEmpty() ? property->valueText() : property->toolTip();
+        break;
+    case Qt::StatusTipRole:
+        return property->statusTip();
+    case Qt::WhatsThisRole:
+        return property->whatsThis();
+    case Qt::FontRole:
+        if (property->isModified()) {
+            QFont font = QApplication::font();
+            font.setBold(true);
+            return font;
+        }
+        break;
+    case Qt::BackgroundRole:
+        if (m_markPropertiesWithoutValue && !property->hasValue())
+            return QApplication::palette().dark();
+        break;
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+QVariant QtPropertyBrowserModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QVariant();
+    if (section == 0)
+        return QCoreApplication::translate("QtModelPropertyBrowser", "Property");
+    return QCoreApplication::translate("QtModelPropertyBrowser", "Value");
+}
+
+Qt::ItemFlags QtPropertyBrowserModel::flags(const QModelIndex &index) const
+{
+    QtBrowserItem *item = browserItem(index);
+    if (!item)
+        return Qt::NoItemFlags;
+
+    // disabled properties disable their sub properties
+    bool enabled = true;
+    for (QtBrowserItem *i = item; i && enabled; i = i->parent())
+        enabled = i->property()->isEnabled();
+
+    Qt::ItemFlags ret = Qt::ItemIsSelectable;
+    if (enabled)
+        ret |= Qt::ItemIsEnabled;
+    if (enabled && index.column() == 1 && item->property()->hasValue())
+        ret |= Qt::ItemIsEditable;
+    return ret;
+}
+
+// items are consecutive children of the same parent, inserted as one range of rows
+void QtPropertyBrowserModel::insertItems(const QList<QtBrowserItem *> &items, QtBrowserItem *afterItem)
+{
+    if (items.isEmpty())
+        return;
+    QtBrowserItem *parentItem = items.first()->parent();
+    const QModelIndex parentIndex = indexOf(parentItem);
+    QList<QtBrowserItem *> &siblings = m_children[parentItem];
+
+    int r = 0;
+    if (afterItem)
+        r = (!siblings.isEmpty() && siblings.last() == afterItem) ? siblings.size() : row(afterItem) + 1;
+
+    beginInsertRows(parentIndex, r, r + items.size() - 1);
+    for (int i = 0; i < items.size(); ++i) {
+        siblings.insert(r + i, items.at(i));
+        m_rowHints[items.at(i)] = r + i;
+    }
+    endInsertRows();
+}
+
+void QtPropertyBrowserModel::removeItem(QtBrowserItem *item)
+{
+    // sub items were removed before
+    QtBrowserItem *parentItem = item->parent();
+    const int r = row(item);
+    if (r < 0)
+        return;
+
+    beginRemoveRows(indexOf(parentItem), r, r);
+    m_children[parentItem].removeAt(r);
+    m_children.remove(item);
+    m_rowHints.remove(item);
+    m_childIndicators.remove(item);
+    endRemoveRows();
+}
+
+void QtPropertyBrowserModel::changeItem(QtBrowserItem *item)
+{
+    const QModelIndex index = indexOf(item);
+    if (index.isValid())
+        emit dataChanged(index, index.sibling(index.row(), 1));
+}
+
+void QtPropertyBrowserModel::setChildIndicatorShown(QtBrowserItem *item, bool shown)
+{
+    if (shown == m_childIndicators.contains(item))
+        return;
+    if (shown)
+        m_childIndicators.insert(item);
+    else
+        m_childIndicators.remove(item);
+    changeItem(item);
+}
+
+void QtPropertyBrowserModel::setMarkPropertiesWithoutValue(bool mark)
+{
+    if (m_markPropertiesWithoutValue == mark)
+        return;
+    m_markPropertiesWithoutValue = mark;
+    emit layoutChanged();
+}
+
+class QtModelPropertyBrowserPrivate;
+
+/*
+    Creates editors through the editor factories of the browser.
+    The editors write changed values to their property managers directly.
+*/
+class QtModelPropertyEditorDelegate : public QStyledItemDelegate
+{
+public:
+    QtModelPropertyEditorDelegate(QtModelPropertyBrowserPrivate *browserPrivate, QObject *parent)
+        : QStyledItemDelegate(parent), m_browserPrivate(browserPrivate) {}
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+            const QModelIndex &index) const;
+
+    void updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option,
+            const QModelIndex &) const
+        { editor->setGeometry(option.rect.adjusted(0, 0, 0, -1)); }
+
+    void setEditorData(QWidget *, const QModelIndex &) const {}
+    void setModelData(QWidget *, QAbstractItemModel *, const QModelIndex &) const {}
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+        { return QStyledItemDelegate::sizeHint(option, index) + QSize(3, 4); }
+
+private:
+    QtModelPropertyBrowserPrivate *m_browserPrivate;
+};
+
+class QtModelPropertyBrowserPrivate
+{
+    QtModelPropertyBrowser *q_ptr;
+    Q_DECLARE_PUBLIC(QtModelPropertyBrowser)
+
+public:
+    QtModelPropertyBrowserPrivate();
+    void init(QWidget *parent);
+
+    QWidget *createEditor(QtProperty *property, QWidget *parent) const
+        { return q_ptr->createEditor(property, parent); }
+
+    // open editor for value of given row, close editor of previous row
+    void editRow(const QModelIndex &index);
+
+    void slotCollapsed(const QModelIndex &index);
+    void slotExpanded(const QModelIndex &index);
+    void slotCurrentBrowserItemChanged(QtBrowserItem *item);
+    void slotCurrentIndexChanged(const QModelIndex &current, const QModelIndex &previous);
+
+    QTreeView *m_view;
+    QtPropertyBrowserModel *m_model;
+    QPersistentModelIndex m_editedIndex;
+    QtModelPropertyBrowser::ResizeMode m_resizeMode;
+    bool m_browserChangedBlocked;
+};
+
+QWidget *QtModelPropertyEditorDelegate::createEditor(QWidget *parent,
+        const QStyleOptionViewItem &, const QModelIndex &index) const
+{
+    if (index.column() != 1)
+        return 0;
+    QtBrowserItem *item = static_cast<QtBrowserItem *>(index.internalPointer());
+    if (!item || !item->property()->hasValue() || !item->property()->isEnabled())
+        return 0;
+
+    QWidget *editor = m_browserPrivate->createEditor(item->property(), parent);
+    if (editor)
+        editor->setAutoFillBackground(true);
+    return editor;
+}
+
+QtModelPropertyBrowserPrivate::QtModelPropertyBrowserPrivate()
+    : q_ptr(0),
+      m_view(0),
+      m_model(0),
+      m_resizeMode(QtModelPropertyBrowser::Stretch),
+      m_browserChangedBlocked(false)
+{
+}
+
+void QtModelPropertyBrowserPrivate::init(QWidget *parent)
+{
+    QHBoxLayout *layout = new QHBoxLayout(parent);
+    layout->setMargin(0);
+
+    m_model = new QtPropertyBrowserModel(parent);
+    m_view = new QTreeView(parent);
+    m_view->setModel(m_model);
+    m_view->setItemDelegate(new QtModelPropertyEditorDelegate(this, parent));
+    m_view->setIconSize(QSize(18, 18));
+    m_view->setAlternatingRowColors(true);
+    // lets the view lay out rows without asking the delegate for each row
+    m_view->setUniformRowHeights(true);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_view->header()->setSectionsMovable(false);
+    m_view->header()->setSectionResizeMode(QHeaderView::Stretch);
+    layout->addWidget(m_view);
+
+    QObject::connect(m_view, SIGNAL(collapsed(QModelIndex)), q_ptr, SLOT(slotCollapsed(QModelIndex)));
+    QObject::connect(m_view, SIGNAL(expanded(QModelIndex)), q_ptr, SLOT(slotExpanded(QModelIndex)));
+    QObject::connect(m_view->selectionModel(), SIGNAL(currentChanged(QModelIndex,QModelIndex)),
+            q_ptr, SLOT(slotCurrentIndexChanged(QModelIndex,QModelIndex)));
+    QObject::connect(q_ptr, SIGNAL(currentItemChanged(QtBrowserItem*)),
+            q_ptr, SLOT(slotCurrentBrowserItemChanged(QtBrowserItem*)));
+}
+
+void QtModelPropertyBrowserPrivate::editRow(const QModelIndex &index)
+{
+    if (m_editedIndex.isValid())
+        m_view->closePersistentEditor(m_editedIndex);
+    m_editedIndex = QPersistentModelIndex();
+
+    if (!index.isValid())
+        return;
+    const QModelIndex valueIndex = index.sibling(index.row(), 1);
+    if (m_model->flags(valueIndex) & Qt::ItemIsEditable) {
+        m_view->openPersistentEditor(valueIndex);
+        m_editedIndex = valueIndex;
+    }
+}
+
+void QtModelPropertyBrowserPrivate::slotCollapsed(const QModelIndex &index)
+{
+    if (QtBrowserItem *item = m_model->browserItem(index))
+        emit q_ptr->collapsed(item);
+}
+
+void QtModelPropertyBrowserPrivate::slotExpanded(const QModelIndex &index)
+{
+    if (QtBrowserItem *item = m_model->browserItem(index))
+        emit q_ptr->expanded(item);
+}
+
+void QtModelPropertyBrowserPrivate::slotCurrentBrowserItemChanged(QtBrowserItem *item)
+{
+    if (!m_browserChangedBlocked && item != m_model->browserItem(m_view->currentIndex()))
+        m_view->setCurrentIndex(m_model->indexOf(item));
+}
+
+void QtModelPropertyBrowserPrivate::slotCurrentIndexChanged(const QModelIndex &current, const QModelIndex &)
+{
+    editRow(current);
+    m_browserChangedBlocked = true;
+    q_ptr->setCurrentItem(m_model->browserItem(current));
+    m_browserChangedBlocked = false;
+}
+
+/*!
+    \class QtModelPropertyBrowser
+    \internal
+
+    \brief The QtModelPropertyBrowser class provides a QTreeView based
+    property browser which only creates an editor for the current row.
+*/
+
+QtModelPropertyBrowser::QtModelPropertyBrowser(QWidget *parent)
+    : QtAbstractPropertyBrowser(parent), d_ptr(new QtModelPropertyBrowserPrivate)
+{
+    d_ptr->q_ptr = this;
+    d_ptr->init(this);
+}
+
+QtModelPropertyBrowser::~QtModelPropertyBrowser()
+{
+}
+
+int QtModelPropertyBrowser::indentation() const
+{
+    return d_ptr->m_view->indentation();
+}
+
+void QtModelPropertyBrowser::setIndentation(int i)
+{
+    d_ptr->m_view->setIndentation(i);
+}
+
+bool QtModelPropertyBrowser::rootIsDecorated() const
+{
+    return d_ptr->m_view->rootIsDecorated();
+}
+
+void QtModelPropertyBrowser::setRootIsDecorated(bool show)
+{
+    d_ptr->m_view->setRootIsDecorated(show);
+}
+
+bool QtModelPropertyBrowser::alternatingRowColors() const
+{
+    return d_ptr->m_view->alternatingRowColors();
+}
+
+void QtModelPropertyBrowser::setAlternatingRowColors(bool enable)
+{
+    d_ptr->m_view->setAlternatingRowColors(enable);
+}
+
+bool QtModelPropertyBrowser::isHeaderVisible() const
+{
+    return d_ptr->m_view->header()->isVisible();
+}
+
+void QtModelPropertyBrowser::setHeaderVisible(bool visible)
+{
+    d_ptr->m_view->header()->setVisible(visible);
+}
+
+QtModelPropertyBrowser::ResizeMode QtModelPropertyBrowser::resizeMode() const
+{
+    return d_ptr->m_resizeMode;
+}
+
+void QtModelPropertyBrowser::setResizeMode(QtModelPropertyBrowser::ResizeMode mode)
+{
+    if (d_ptr->m_resizeMode == mode)
+        return;
+
+    d_ptr->m_resizeMode = mode;
+    QHeaderView::ResizeMode m = QHeaderView::Stretch;
+    switch (mode) {
+        case QtModelPropertyBrowser::Interactive:      m = QHeaderView::Interactive;      break;
+        case QtModelPropertyBrowser::Fixed:            m = QHeaderView::Fixed;            break;
+        case QtModelPropertyBrowser::ResizeToContents: m = QHeaderView::ResizeToContents; break;
+        case QtModelPropertyBrowser::Stretch:
+        default:                                       m = QHeaderView::Stretch;          break;
+    }
+    d_ptr->m_view->header()->setSectionResizeMode(m);
+}
+
+int QtModelPropertyBrowser::splitterPosition() const
+{
+    return d_ptr->m_view->header()->sectionSize(0);
+}
+
+void QtModelPropertyBrowser::setSplitterPosition(int position)
+{
+    d_ptr->m_view->header()->resizeSection(0, position);
+}
+
+void QtModelPropertyBrowser::setExpanded(QtBrowserItem *item, bool expanded)
+{
+    const QModelIndex index = d_ptr->m_model->indexOf(item);
+    if (index.isValid())
+        d_ptr->m_view->setExpanded(index, expanded);
+}
+
+bool QtModelPropertyBrowser::isExpanded(QtBrowserItem *item) const
+{
+    const QModelIndex index = d_ptr->m_model->indexOf(item);
+    return index.isValid() && d_ptr->m_view->isExpanded(index);
+}
+
+bool QtModelPropertyBrowser::isItemVisible(QtBrowserItem *item) const
+{
+    const QModelIndex index = d_ptr->m_model->indexOf(item);
+    return index.isValid() && !d_ptr->m_view->isRowHidden(index.row(), index.parent());
+}
+
+void QtModelPropertyBrowser::setItemVisible(QtBrowserItem *item, bool visible)
+{
+    const QModelIndex index = d_ptr->m_model->indexOf(item);
+    if (index.isValid())
+        d_ptr->m_view->setRowHidden(index.row(), index.parent(), !visible);
+}
+
+/*!
+    Shows the expand indicator for \a item even if it has no children yet,
+    depending on the value of \a shown. Used for items whose children are
+    created when the item is expanded.
+*/
+void QtModelPropertyBrowser::setChildIndicatorShown(QtBrowserItem *item, bool shown)
+{
+    d_ptr->m_model->setChildIndicatorShown(item, shown);
+}
+
+void QtModelPropertyBrowser::setPropertiesWithoutValueMarked(bool mark)
+{
+    d_ptr->m_model->setMarkPropertiesWithoutValue(mark);
+}
+
+bool QtModelPropertyBrowser::propertiesWithoutValueMarked() const
+{
+    return d_ptr->m_model->markPropertiesWithoutValue();
+}
+
+/*!
+    Sets the current item to \a item and opens the editor for it.
+*/
+void QtModelPropertyBrowser::editItem(QtBrowserItem *item)
+{
+    setCurrentItem(item);
+    d_ptr->m_view->setFocus();
+}
+
+/*!
+    Returns the property shown at position \a p in browser coordinates.
+*/
+QtProperty* QtModelPropertyBrowser::propertyAt(const QPoint& p)
+{
+    const QPoint local = d_ptr->m_view->viewport()->mapFrom(this, p);
+    QtBrowserItem *item = d_ptr->m_model->browserItem(d_ptr->m_view->indexAt(local));
+    return item ? item->property() : 0;
+}
+
+/*!
+    \reimp
+*/
+void QtModelPropertyBrowser::itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem)
+{
+    itemsInserted(QList<QtBrowserItem *>() << item, afterItem);
+}
+
+/*!
+    \reimp
+*/
+void QtModelPropertyBrowser::itemsInserted(const QList<QtBrowserItem *> &items, QtBrowserItem *afterItem)
+{
+    d_ptr->m_model->insertItems(items, afterItem);
+
+    // show sub properties like QtTreePropertyBrowser. Leafs are not expanded,
+    // that would keep a persistent index for every row.
+    QListIterator<QtBrowserItem *> it(items);
+    while (it.hasNext()) {
+        QtBrowserItem *item = it.next();
+        if (!item->property()->subProperties().isEmpty())
+            setExpanded(item, true);
+    }
+    QtBrowserItem *parentItem = items.first()->parent();
+    if (parentItem && parentItem->children().size() == items.size())
+        setExpanded(parentItem, true);
+}
+
+/*!
+    \reimp
+*/
+void QtModelPropertyBrowser::itemRemoved(QtBrowserItem *item)
+{
+    d_ptr->m_model->removeItem(item);
+}
+
+/*!
+    \reimp
+*/
+void QtModelPropertyBrowser::itemChanged(QtBrowserItem *item)
+{
+    d_ptr->m_model->changeItem(item);
+}
+
+/*!
+    \reimp
+*/
+void QtModelPropertyBrowser::updateStarted()
+{
+    d_ptr->m_view->setUpdatesEnabled(false);
+}
+
+/*!
+    \reimp
+*/
+void QtModelPropertyBrowser::updateFinished()
+{
+    d_ptr->m_view->setUpdatesEnabled(true);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qtmodelpropertybrowser.cpp"
@@ -80,6 +80,8 @@ public:
                 QtProperty *parentProperty) const;
     void propertyInserted(QtProperty *property, QtProperty *parentProperty,
                 QtProperty *afterProperty) const;
+    void propertiesInserted(const QList<QtProperty *> &properties, QtProperty *parentProperty,
+                QtProperty *afterProperty) const;
 
     QSet<QtProperty *> m_properties;
 };
@@ -409,50 +411,69 @@ void QtProperty::addSubProperty(QtProperty *property)
     If the given \a property already is inserted, this function does
     nothing.
 
-    \sa addSubProperty(), removeSubProperty()
+    \sa addSubProperty(), insertSubProperties(), removeSubProperty()
 */
 void QtProperty::insertSubProperty(QtProperty *property,
             QtProperty *afterProperty)
 {
-    if (!property)
-        return;
+    insertSubProperties(QList<QtProperty *>() << property, afterProperty);
+}
 
-    if (property == this)
+/*!
+    Inserts the given \a properties in their order after the specified \a
+    afterProperty into this property's list of subproperties.  If
+    \a afterProperty is 0, the properties are inserted at the beginning
+    of the list.
+
+    Properties which already are subproperties of this property, or
+    which would create a cycle, are skipped. The ancestors and current
+    subproperties of this property are collected once for all inserted
+    properties, the subtrees of the inserted properties are not traversed.
+
+    \sa insertSubProperty(), addSubProperty()
+*/
+void QtProperty::insertSubProperties(const QList<QtProperty *> &properties,
+            QtProperty *afterProperty)
+{
+    if (properties.isEmpty())
         return;
 
-    // traverse all children of item. if this item is a child of item then cannot add.
-    QList<QtProperty *> pendingList = property->subProperties();
-    QMap<QtProperty *, bool> visited;
+    // a property creates a cycle if it is this property or one of its ancestors.
+    QSet<QtProperty *> ancestors;
+    QList<QtProperty *> pendingList;
+    pendingList.append(this);
     while (!pendingList.isEmpty()) {
-        QtProperty *i = pendingList.first();
-        if (i == this)
-            return;
-        pendingList.removeFirst();
-        if (visited.contains(i))
+        QtProperty *i = pendingList.takeLast();
+        if (ancestors.contains(i))
             continue;
-        visited[i] = true;
-        pendingList += i->subProperties();
+        ancestors.insert(i);
+        pendingList += i->d_ptr->m_parentItems.toList();
     }
 
-    pendingList = subProperties();
-    int pos = 0;
-    int newPos = 0;
-    QtProperty *properAfterProperty = 0;
-    while (pos < pendingList.count()) {
-        QtProperty *i = pendingList.at(pos);
-        if (i == property)
-            return; // if item is already inserted in this item then cannot add.
-        if (i == afterProperty) {
-            newPos = pos + 1;
-            properAfterProperty = afterProperty;
-        }
-        pos++;
-    }
+    QSet<QtProperty *> subItems = d_ptr->m_subItems.toSet();
+    int newPos = afterProperty ? d_ptr->m_subItems.indexOf(afterProperty) + 1 : 0;
+    QtProperty *properAfterProperty = newPos > 0 ? afterProperty : 0;
+    QtProperty *firstAfterProperty = properAfterProperty;
 
-    d_ptr->m_subItems.insert(newPos, property);
-    property->d_ptr->m_parentItems.insert(this);
+    QList<QtProperty *> inserted;
+    QListIterator<QtProperty *> it(properties);
+    while (it.hasNext()) {
+        QtProperty *property = it.next();
+        if (!property || ancestors.contains(property) || subItems.contains(property))
+            continue;
+
+        subItems.insert(property);
+        d_ptr->m_subItems.insert(newPos++, property);
+        property->d_ptr->m_parentItems.insert(this);
+        inserted.append(property);
+
+        d_ptr->m_manager->d_ptr->propertyInserted(property, this, properAfterProperty);
+        properAfterProperty = property;
+    }
 
-    d_ptr->m_manager->d_ptr->propertyInserted(property, this, properAfterProperty);
+    // browsers insert all properties with a single notification
+    if (!inserted.isEmpty())
+        d_ptr->m_manager->d_ptr->propertiesInserted(inserted, this, firstAfterProperty);
 }
 
 /*!
@@ -517,6 +538,12 @@ void QtAbstractPropertyManagerPrivate::propertyInserted(QtProperty *property,
     emit q_ptr->propertyInserted(property, parentProperty, afterProperty);
 }
 
+void QtAbstractPropertyManagerPrivate::propertiesInserted(const QList<QtProperty *> &properties,
+            QtProperty *parentProperty, QtProperty *afterProperty) const
+{
+    emit q_ptr->propertiesInserted(properties, parentProperty, afterProperty);
+}
+
 /*!
     \class QtAbstractPropertyManager
     \internal
@@ -585,7 +612,20 @@ void QtAbstractPropertyManagerPrivate::propertyInserted(QtProperty *property,
     Note that signal is emitted only if the \a parentProperty is created
     by this manager.
 
-    \sa QtAbstractPropertyBrowser::itemInserted()
+    \sa QtAbstractPropertyBrowser::itemInserted(), propertiesInserted()
+*/
+
+/*!
+    \fn void QtAbstractPropertyManager::propertiesInserted(const QList<QtProperty *> &properties,
+                QtProperty *parentProperty, QtProperty *precedingProperty)
+
+    This signal is emitted once after QtProperty::insertSubProperties()
+    inserted the given \a properties in their order after \a precedingProperty
+    into \a parentProperty. propertyInserted() is emitted for each of the
+    properties before. Property browsers use this signal to insert all
+    properties with a single call to QtAbstractPropertyBrowser::itemsInserted().
+
+    \sa propertyInserted()
 */
 
 /*!
@@ -1078,6 +1118,11 @@ public:
 
 void QtBrowserItemPrivate::addChild(QtBrowserItem *index, QtBrowserItem *after)
 {
+    if (after && !m_children.isEmpty() && m_children.last() == after) {
+        // appending, index is newly created so it can not be a child yet
+        m_children.append(index);
+        return;
+    }
     if (m_children.contains(index))
         return;
     int idx = m_children.indexOf(after) + 1; // we insert after returned idx, if it was -1 then we set idx to 0;
@@ -1194,12 +1239,15 @@ public:
     void removeSubTree(QtProperty *property,
             QtProperty *parentProperty);
     void createBrowserIndexes(QtProperty *property, QtProperty *parentProperty, QtProperty *afterProperty);
+    void createBrowserIndexes(const QList<QtProperty *> &properties, QtProperty *parentProperty, QtProperty *afterProperty);
     void removeBrowserIndexes(QtProperty *property, QtProperty *parentProperty);
     QtBrowserItem *createBrowserIndex(QtProperty *property, QtBrowserItem *parentIndex, QtBrowserItem *afterIndex);
+    QList<QtBrowserItem *> createBrowserIndexes(const QList<QtProperty *> &properties,
+            QtBrowserItem *parentIndex, QtBrowserItem *afterIndex);
     void removeBrowserIndex(QtBrowserItem *index);
     void clearIndex(QtBrowserItem *index);
 
-    void slotPropertyInserted(QtProperty *property,
+    void slotPropertiesInserted(const QList<QtProperty *> &properties,
             QtProperty *parentProperty, QtProperty *afterProperty);
     void slotPropertyRemoved(QtProperty *property, QtProperty *parentProperty);
     void slotPropertyDestroyed(QtProperty *property);
@@ -1214,10 +1262,12 @@ public:
     QMap<QtProperty *, QList<QtBrowserItem *> > m_propertyToIndexes;
 
     QtBrowserItem *m_currentItem;
+    int m_updateDepth;
 };
 
 QtAbstractPropertyBrowserPrivate::QtAbstractPropertyBrowserPrivate() :
-   m_currentItem(0)
+   m_currentItem(0),
+   m_updateDepth(0)
 {
 }
 
@@ -1236,9 +1286,9 @@ void QtAbstractPropertyBrowserPrivate::insertSubTree(QtProperty *property,
     QtAbstractPropertyManager *manager = property->propertyManager();
     if (m_managerToProperties[manager].isEmpty()) {
         // connect manager's signals
-        q_ptr->connect(manager, SIGNAL(propertyInserted(QtProperty *,
+        q_ptr->connect(manager, SIGNAL(propertiesInserted(QList<QtProperty *>,
                             QtProperty *, QtProperty *)),
-                q_ptr, SLOT(slotPropertyInserted(QtProperty *,
+                q_ptr, SLOT(slotPropertiesInserted(QList<QtProperty *>,
                             QtProperty *, QtProperty *)));
         q_ptr->connect(manager, SIGNAL(propertyRemoved(QtProperty *,
                             QtProperty *)),
@@ -1276,9 +1326,9 @@ void QtAbstractPropertyBrowserPrivate::removeSubTree(QtProperty *property,
     m_managerToProperties[manager].removeAll(property);
     if (m_managerToProperties[manager].isEmpty()) {
         // disconnect manager's signals
-        q_ptr->disconnect(manager, SIGNAL(propertyInserted(QtProperty *,
+        q_ptr->disconnect(manager, SIGNAL(propertiesInserted(QList<QtProperty *>,
                             QtProperty *, QtProperty *)),
-                q_ptr, SLOT(slotPropertyInserted(QtProperty *,
+                q_ptr, SLOT(slotPropertiesInserted(QList<QtProperty *>,
                             QtProperty *, QtProperty *)));
         q_ptr->disconnect(manager, SIGNAL(propertyRemoved(QtProperty *,
                             QtProperty *)),
@@ -1300,6 +1350,11 @@ void QtAbstractPropertyBrowserPrivate::removeSubTree(QtProperty *property,
 }
 
 void QtAbstractPropertyBrowserPrivate::createBrowserIndexes(QtProperty *property, QtProperty *parentProperty, QtProperty *afterProperty)
+{
+    createBrowserIndexes(QList<QtProperty *>() << property, parentProperty, afterProperty);
+}
+
+void QtAbstractPropertyBrowserPrivate::createBrowserIndexes(const QList<QtProperty *> &properties, QtProperty *parentProperty, QtProperty *afterProperty)
 {
     QMap<QtBrowserItem *, QtBrowserItem *> parentToAfter;
     if (afterProperty) {
@@ -1334,31 +1389,46 @@ void QtAbstractPropertyBrowserPrivate::createBrowserIndexes(QtProperty *property
 
     const QMap<QtBrowserItem *, QtBrowserItem *>::ConstIterator pcend = parentToAfter.constEnd();
     for (QMap<QtBrowserItem *, QtBrowserItem *>::ConstIterator it = parentToAfter.constBegin(); it != pcend; ++it)
-        createBrowserIndex(property, it.key(), it.value());
+        createBrowserIndexes(properties, it.key(), it.value());
 }
 
 QtBrowserItem *QtAbstractPropertyBrowserPrivate::createBrowserIndex(QtProperty *property,
         QtBrowserItem *parentIndex, QtBrowserItem *afterIndex)
 {
-    QtBrowserItem *newIndex = new QtBrowserItem(q_ptr, property, parentIndex);
-    if (parentIndex) {
-        parentIndex->d_ptr->addChild(newIndex, afterIndex);
-    } else {
-        m_topLevelPropertyToIndex[property] = newIndex;
-        m_topLevelIndexes.insert(m_topLevelIndexes.indexOf(afterIndex) + 1, newIndex);
+    return createBrowserIndexes(QList<QtProperty *>() << property, parentIndex, afterIndex).first();
+}
+
+QList<QtBrowserItem *> QtAbstractPropertyBrowserPrivate::createBrowserIndexes(const QList<QtProperty *> &properties,
+        QtBrowserItem *parentIndex, QtBrowserItem *afterIndex)
+{
+    // create the items of all properties before notifying the browser once
+    QList<QtBrowserItem *> newIndexes;
+    QtBrowserItem *after = afterIndex;
+    QListIterator<QtProperty *> itProperty(properties);
+    while (itProperty.hasNext()) {
+        QtProperty *property = itProperty.next();
+        QtBrowserItem *newIndex = new QtBrowserItem(q_ptr, property, parentIndex);
+        if (parentIndex) {
+            parentIndex->d_ptr->addChild(newIndex, after);
+        } else {
+            m_topLevelPropertyToIndex[property] = newIndex;
+            m_topLevelIndexes.insert(m_topLevelIndexes.indexOf(after) + 1, newIndex);
+        }
+        m_propertyToIndexes[property].append(newIndex);
+        newIndexes.append(newIndex);
+        after = newIndex;
     }
-    m_propertyToIndexes[property].append(newIndex);
 
-    q_ptr->itemInserted(newIndex, afterIndex);
+    q_ptr->itemsInserted(newIndexes, afterIndex);
 
-    QList<QtProperty *> subItems = property->subProperties();
-    QListIterator<QtProperty *> itChild(subItems);
-    QtBrowserItem *afterChild = 0;
-    while (itChild.hasNext()) {
-        QtProperty *child = itChild.next();
-        afterChild = createBrowserIndex(child, newIndex, afterChild);
+    QListIterator<QtBrowserItem *> itIndex(newIndexes);
+    while (itIndex.hasNext()) {
+        QtBrowserItem *newIndex = itIndex.next();
+        const QList<QtProperty *> subItems = newIndex->property()->subProperties();
+        if (!subItems.isEmpty())
+            createBrowserIndexes(subItems, newIndex, 0);
     }
-    return newIndex;
+    return newIndexes;
 }
 
 void QtAbstractPropertyBrowserPrivate::removeBrowserIndexes(QtProperty *property, QtProperty *parentProperty)
@@ -1420,14 +1490,15 @@ void QtAbstractPropertyBrowserPrivate::clearIndex(QtBrowserItem *index)
     delete index;
 }
 
-void QtAbstractPropertyBrowserPrivate::slotPropertyInserted(QtProperty *property,
+void QtAbstractPropertyBrowserPrivate::slotPropertiesInserted(const QList<QtProperty *> &properties,
         QtProperty *parentProperty, QtProperty *afterProperty)
 {
     if (!m_propertyToParents.contains(parentProperty))
         return;
-    createBrowserIndexes(property, parentProperty, afterProperty);
-    insertSubTree(property, parentProperty);
-    //q_ptr->propertyInserted(property, parentProperty, afterProperty);
+    createBrowserIndexes(properties, parentProperty, afterProperty);
+    QListIterator<QtProperty *> it(properties);
+    while (it.hasNext())
+        insertSubTree(it.next(), parentProperty);
 }
 
 void QtAbstractPropertyBrowserPrivate::slotPropertyRemoved(QtProperty *property,
@@ -1596,11 +1667,35 @@ void QtAbstractPropertyBrowserPrivate::slotPropertyDataChanged(QtProperty *prope
 
     This function must be reimplemented in derived classes. Note that
     if the \a insertedItem's property has subproperties, this
-    method will be called for those properties as soon as the current call is finished.
+    method will be called for those properties after the items of all
+    properties inserted together with \a insertedItem are inserted.
 
-    \sa insertProperty(), addProperty()
+    \sa insertProperty(), addProperty(), itemsInserted()
 */
 
+/*!
+    This function is called once for all \a items of properties inserted
+    together into the same parent, e.g. by QtProperty::insertSubProperties().
+    The \a items are consecutive and follow \a precedingItem in their parent.
+    All items already are children of their parent item when this function
+    is called, their subproperties are inserted afterwards.
+
+    The default implementation calls itemInserted() for each item.
+    Reimplement it to insert all items with a single update.
+
+    \sa itemInserted()
+*/
+void QtAbstractPropertyBrowser::itemsInserted(const QList<QtBrowserItem *> &items, QtBrowserItem *precedingItem)
+{
+    QtBrowserItem *after = precedingItem;
+    QListIterator<QtBrowserItem *> it(items);
+    while (it.hasNext()) {
+        QtBrowserItem *item = it.next();
+        itemInserted(item, after);
+        after = item;
+    }
+}
+
 /*!
     \fn virtual void QtAbstractPropertyBrowser::itemRemoved(QtBrowserItem *item) = 0
 
@@ -1954,6 +2049,41 @@ void QtAbstractPropertyBrowser::setCurrentItem(QtBrowserItem *item)
         emit  currentItemChanged(item);
 }
 
+/*!
+    Starts a bulk update scope. Use it around the insertion or removal
+    of many properties, the browser then can postpone the per-item work
+    until endUpdate() is called. Scopes can be nested.
+
+    \sa endUpdate(), isUpdating()
+*/
+void QtAbstractPropertyBrowser::beginUpdate()
+{
+    if (d_ptr->m_updateDepth++ == 0)
+        updateStarted();
+}
+
+/*!
+    Finishes a bulk update scope started with beginUpdate().
+
+    \sa beginUpdate(), isUpdating()
+*/
+void QtAbstractPropertyBrowser::endUpdate()
+{
+    Q_ASSERT(d_ptr->m_updateDepth > 0);
+    if (--d_ptr->m_updateDepth == 0)
+        updateFinished();
+}
+
+/*!
+    Returns true while a bulk update scope is open.
+
+    \sa beginUpdate()
+*/
+bool QtAbstractPropertyBrowser::isUpdating() const
+{
+    return d_ptr->m_updateDepth > 0;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qtpropertybrowser.cpp"
@@ -79,6 +79,7 @@ public:
 
     void addSubProperty(QtProperty *property);
     void insertSubProperty(QtProperty *property, QtProperty *afterProperty);
+    void insertSubProperties(const QList<QtProperty *> &properties, QtProperty *afterProperty);
     void insertSubPropertyBefore(QtProperty *property, QtProperty *beforeProperty);
     void removeSubProperty(QtProperty *property);
 protected:
@@ -107,6 +108,8 @@ Q_SIGNALS:
 
     void propertyInserted(QtProperty *property,
                 QtProperty *parent, QtProperty *after);
+    void propertiesInserted(const QList<QtProperty *> &properties,
+                QtProperty *parent, QtProperty *after);
     void propertyChanged(QtProperty *property);
     void propertyRemoved(QtProperty *property, QtProperty *parent);
     void propertyDestroyed(QtProperty *property);
@@ -271,6 +274,10 @@ public:
     QtBrowserItem *currentItem() const;
     void setCurrentItem(QtBrowserItem *);
 
+    void beginUpdate();
+    void endUpdate();
+    bool isUpdating() const;
+
 Q_SIGNALS:
     void currentItemChanged(QtBrowserItem *);
 
@@ -283,11 +290,16 @@ public Q_SLOTS:
 protected:
 
     virtual void itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem) = 0;
+    virtual void itemsInserted(const QList<QtBrowserItem *> &items, QtBrowserItem *afterItem);
     virtual void itemRemoved(QtBrowserItem *item) = 0;
     // can be tooltip, statustip, whatsthis, name, icon, text.
     virtual void itemChanged(QtBrowserItem *item) = 0;
 
     virtual QWidget *createEditor(QtProperty *property, QWidget *parent);
+
+    // called when the outermost bulk update scope starts and finishes
+    virtual void updateStarted() {}
+    virtual void updateFinished() {}
 private:
 
     bool addFactory(QtAbstractPropertyManager *abstractManager,
@@ -296,7 +308,7 @@ private:
     QScopedPointer<QtAbstractPropertyBrowserPrivate> d_ptr;
     Q_DECLARE_PRIVATE(QtAbstractPropertyBrowser)
     Q_DISABLE_COPY(QtAbstractPropertyBrowser)
-    Q_PRIVATE_SLOT(d_func(), void slotPropertyInserted(QtProperty *,
+    Q_PRIVATE_SLOT(d_func(), void slotPropertiesInserted(const QList<QtProperty *> &,
                             QtProperty *, QtProperty *))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyRemoved(QtProperty *,
                             QtProperty *))
@@ -545,7 +545,12 @@ void QtTreePropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBrow
     QTreeWidgetItem *parentItem = m_indexToItem.value(index->parent());
 
     QTreeWidgetItem *newItem = 0;
-    if (parentItem) {
+    if (parentItem && afterItem && parentItem->childCount() > 0 &&
+            parentItem->child(parentItem->childCount() - 1) == afterItem) {
+        // appending, avoid searching the position of afterItem
+        newItem = new QTreeWidgetItem();
+        parentItem->addChild(newItem);
+    } else if (parentItem) {
         newItem = new QTreeWidgetItem(parentItem, afterItem);
     } else {
         newItem = new QTreeWidgetItem(m_treeWidget, afterItem);
@@ -1039,6 +1044,22 @@ void QtTreePropertyBrowser::itemChanged(QtBrowserItem *item)
     d_ptr->propertyChanged(item);
 }
 
+/*!
+    \reimp
+*/
+void QtTreePropertyBrowser::updateStarted()
+{
+    d_ptr->treeWidget()->setUpdatesEnabled(false);
+}
+
+/*!
+    \reimp
+*/
+void QtTreePropertyBrowser::updateFinished()
+{
+    d_ptr->treeWidget()->setUpdatesEnabled(true);
+}
+
 /*!
     Sets the current item to \a item and opens the relevant editor for it.
 */
@@ -42,6 +42,7 @@
 #include "qtvariantproperty.h"
 #include "qtpropertymanager.h"
 #include "qteditorfactory.h"
+#include <QtCore/QHash>
 #include <QtCore/QVariant>
 #include <QtGui/QIcon>
 #include <QtCore/QDate>
@@ -130,7 +131,7 @@ int QtVariantPropertyManager::iconMapTypeId()
     return qMetaTypeId<QtIconMap>();
 }
 
-typedef QMap<const QtProperty *, QtProperty *> PropertyMap;
+typedef QHash<const QtProperty *, QtProperty *> PropertyMap;
 Q_GLOBAL_STATIC(PropertyMap, propertyToWrappedProperty)
 
 static QtProperty *wrappedProperty(QtProperty *property)
@@ -337,15 +338,15 @@ public:
             QtProperty *internal);
     void removeSubProperty(QtVariantProperty *property);
 
-    QMap<int, QtAbstractPropertyManager *> m_typeToPropertyManager;
-    QMap<int, QMap<QString, int> > m_typeToAttributeToAttributeType;
+    QHash<int, QtAbstractPropertyManager *> m_typeToPropertyManager;
+    QHash<int, QHash<QString, int> > m_typeToAttributeToAttributeType;
 
-    QMap<const QtProperty *, QPair<QtVariantProperty *, int> > m_propertyToType;
+    QHash<const QtProperty *, QPair<QtVariantProperty *, int> > m_propertyToType;
 
-    QMap<int, int> m_typeToValueType;
+    QHash<int, int> m_typeToValueType;
 
 
-    QMap<QtProperty *, QtVariantProperty *> m_internalToProperty;
+    QHash<QtProperty *, QtVariantProperty *> m_internalToProperty;
 
     const QString m_constraintAttribute;
     const QString m_singleStepAttribute;
@@ -1243,7 +1244,7 @@ QtVariantPropertyManager::~QtVariantPropertyManager()
 */
 QtVariantProperty *QtVariantPropertyManager::variantProperty(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
+    const QHash<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
     if (it == d_ptr->m_propertyToType.constEnd())
         return 0;
     return it.value().first;
@@ -1390,7 +1391,7 @@ int QtVariantPropertyManager::valueType(int propertyType) const
 */
 int QtVariantPropertyManager::propertyType(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
+    const QHash<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
     if (it == d_ptr->m_propertyToType.constEnd())
         return 0;
     return it.value().second;
@@ -1412,13 +1413,13 @@ QVariant QtVariantPropertyManager::attributeValue(const QtProperty *property, co
     if (!propType)
         return QVariant();
 
-    QMap<int, QMap<QString, int> >::ConstIterator it =
+    QHash<int, QHash<QString, int> >::ConstIterator it =
             d_ptr->m_typeToAttributeToAttributeType.find(propType);
     if (it == d_ptr->m_typeToAttributeToAttributeType.constEnd())
         return QVariant();
 
-    QMap<QString, int> attributes = it.value();
-    QMap<QString, int>::ConstIterator itAttr = attributes.find(attribute);
+    QHash<QString, int> attributes = it.value();
+    QHash<QString, int>::ConstIterator itAttr = attributes.find(attribute);
     if (itAttr == attributes.constEnd())
         return QVariant();
 
@@ -1507,11 +1508,14 @@ QVariant QtVariantPropertyManager::attributeValue(const QtProperty *property, co
 */
 QStringList QtVariantPropertyManager::attributes(int propertyType) const
 {
-    QMap<int, QMap<QString, int> >::ConstIterator it =
+    QHash<int, QHash<QString, int> >::ConstIterator it =
             d_ptr->m_typeToAttributeToAttributeType.find(propertyType);
     if (it == d_ptr->m_typeToAttributeToAttributeType.constEnd())
         return QStringList();
-    return it.value().keys();
+    // keep attributes in a stable order
+    QStringList attributes = it.value().keys();
+    attributes.sort();
+    return attributes;
 }
 
 /*!
@@ -1526,13 +1530,13 @@ QStringList QtVariantPropertyManager::attributes(int propertyType) const
 */
 int QtVariantPropertyManager::attributeType(int propertyType, const QString &attribute) const
 {
-    QMap<int, QMap<QString, int> >::ConstIterator it =
+    QHash<int, QHash<QString, int> >::ConstIterator it =
             d_ptr->m_typeToAttributeToAttributeType.find(propertyType);
     if (it == d_ptr->m_typeToAttributeToAttributeType.constEnd())
         return 0;
 
-    QMap<QString, int> attributes = it.value();
-    QMap<QString, int>::ConstIterator itAttr = attributes.find(attribute);
+    QHash<QString, int> attributes = it.value();
+    QHash<QString, int>::ConstIterator itAttr = attributes.find(attribute);
     if (itAttr == attributes.constEnd())
         return 0;
     return itAttr.value();
@@ -1776,7 +1780,7 @@ void QtVariantPropertyManager::initializeProperty(QtProperty *property)
     if (!varProp)
         return;
 
-    QMap<int, QtAbstractPropertyManager *>::ConstIterator it =
+    QHash<int, QtAbstractPropertyManager *>::ConstIterator it =
             d_ptr->m_typeToPropertyManager.find(d_ptr->m_propertyType);
     if (it != d_ptr->m_typeToPropertyManager.constEnd()) {
         QtProperty *internProp = 0;
@@ -1803,7 +1807,7 @@ void QtVariantPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtVariantPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::iterator type_it = d_ptr->m_propertyToType.find(property);
+    const QHash<const QtProperty *, QPair<QtVariantProperty *, int> >::iterator type_it = d_ptr->m_propertyToType.find(property);
     if (type_it == d_ptr->m_propertyToType.end())
         return;
 
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "allocationtracker.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <cstdio>
+
+// written by benchmarks so the compiler can not drop the measured work
+static volatile qint64 s_benchSink = 0;
+
+
+/**
+ * Runs timed operations, prints the results and writes them as JSON.
+ * Each operation is run once, count is the number of components
+ * or entities the operation was applied to.
+ * Heap allocations of each operation are counted when the allocation tracker
+ * is available, and can be checked against a budget with expectAllocations.
+ */
+class Benchmark
+{
+public:
+
+    struct Result
+    {
+        QString _name;
+        QString _backend;
+        int _count;
+        qint64 _nsecs;
+        quint64 _allocations;
+        quint64 _bytes;
+    };
+
+    template <typename F>
+    void run(const QString& name, const QString& backend, int count, F func)
+    {
+        QElapsedTimer timer;
+        AllocationScope allocations;
+        timer.start();
+        func();
+        qint64 nsecs = timer.nsecsElapsed();
+        AllocationCount allocated = allocations.count();
+
+        Result r;
+        r._name = name;
+        r._backend = backend;
+        r._count = count;
+        r._nsecs = nsecs;
+        r._allocations = allocated._allocations;
+        r._bytes = allocated._bytes;
+        _results.push_back(r);
+
+        printf("%-22s %-8s %10d %14.1f ns/op %12.3f ms %10.1f allocs/op\n",
+               qPrintable(name), qPrintable(backend), count,
+               double(r._nsecs) / qMax(count, 1), double(r._nsecs) / 1000000.0,
+               double(r._allocations) / qMax(count, 1));
+        fflush(stdout);
+    }
+
+    /**
+     * Check that the last run operation did at most maxPerOp allocations
+     * per component or entity on average. Failed checks are printed and
+     * make failures() non-empty. Does nothing if allocations are not tracked.
+     */
+    void expectAllocations(double maxPerOp)
+    {
+        if(!AllocationTracker::isAvailable() || _results.empty()) return;
+        const Result& r = _results.back();
+        double perOp = double(r._allocations) / qMax(r._count, 1);
+        if(perOp > maxPerOp)
+        {
+            QString msg = QString("%1 %2 %3: %4 allocations per op, budget is %5")
+                    .arg(r._name).arg(r._backend).arg(r._count).arg(perOp).arg(maxPerOp);
+            printf("ALLOCATION BUDGET EXCEEDED: %s\n", qPrintable(msg));
+            fflush(stdout);
+            _failures.push_back(msg);
+        }
+    }
+
+    const QStringList& failures() const { return _failures; }
+
+    const QVector<Result>& results() const { return _results; }
+
+    bool writeJson(const QString& path) const
+    {
+        QJsonArray results;
+        foreach(const Result& r, _results)
+        {
+            QJsonObject o;
+            o["name"] = r._name;
+            o["backend"] = r._backend;
+            o["count"] = r._count;
+            o["total_ns"] = double(r._nsecs);
+            o["ns_per_op"] = double(r._nsecs) / qMax(r._count, 1);
+            if(AllocationTracker::isAvailable())
+            {
+                o["allocations"] = double(r._allocations);
+                o["allocated_bytes"] = double(r._bytes);
+            }
+            results.append(o);
+        }
+
+        QJsonObject root;
+        root["benchmark"] = QString("qtentity_bench");
+        root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        root["qt_version"] = QString(qVersion());
+#ifdef QT_NO_DEBUG
+        root["build"] = QString("release");
+#else
+        root["build"] = QString("debug");
+#endif
+        root["results"] = results;
+        root["allocation_budget_failures"] = QJsonArray::fromStringList(_failures);
+
+        QFile file(path);
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        file.write(QJsonDocument(root).toJson());
+        return true;
+    }
+
+private:
+
+    QVector<Result> _results;
+    QStringList _failures;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QtEntity/EntityManager>
+#include <QtEntity/PooledEntitySystem>
+#include <QtEntity/ReflectedEntitySystem>
+#include <QtEntity/SimpleEntitySystem>
+#include <QVector>
+
+using namespace QtEntity;
+
+
+struct BenchComponent
+{
+    BenchComponent() : _value(0), _x(0), _y(0) {}
+
+    qint32 _value;
+    double _x;
+    double _y;
+};
+
+Q_DECLARE_METATYPE(BenchComponent)
+
+
+// adds variant map conversion of BenchComponent to a storage backend
+template <typename Base>
+class BenchSystem : public Base
+{
+public:
+
+    template <typename... Args>
+    BenchSystem(EntityManager* em, Args... args)
+        : Base(em, args...)
+    {
+    }
+
+    virtual QVariantMap toVariantMap(EntityId eid, int context = 0) override
+    {
+        BenchComponent* c;
+        if(this->component(eid, c))
+        {
+            return componentToVariantMap(*c, context);
+        }
+        return QVariantMap();
+    }
+
+    static QVariantMap componentToVariantMap(const BenchComponent& c, int context)
+    {
+        Q_UNUSED(context)
+        QVariantMap m;
+        m["value"] = c._value;
+        m["x"]     = c._x;
+        m["y"]     = c._y;
+        return m;
+    }
+
+    virtual void fromVariantMap(EntityId eid, const QVariantMap& m, int context = 0) override
+    {
+        Q_UNUSED(context)
+        BenchComponent* c;
+        if(this->component(eid, c))
+        {
+            if(m.contains("value")) c->_value = m["value"].toInt();
+            if(m.contains("x"))     c->_x = m["x"].toDouble();
+            if(m.contains("y"))     c->_y = m["y"].toDouble();
+        }
+    }
+};
+
+typedef BenchSystem<SimpleEntitySystem<BenchComponent> > BenchSimpleSystem;
+typedef BenchSystem<PooledEntitySystem<BenchComponent> > BenchPooledSystem;
+
+
+// component with properties read by moc, accessed by script benchmarks
+class BenchReflected
+{
+    Q_GADGET
+    Q_PROPERTY(qint32 value MEMBER _value)
+    Q_PROPERTY(double x MEMBER _x)
+
+public:
+
+    BenchReflected() : _value(0), _x(0) {}
+
+    qint32 _value;
+    double _x;
+};
+
+Q_DECLARE_METATYPE(BenchReflected)
+
+typedef ReflectedEntitySystem<BenchReflected> BenchReflectedSystem;
+
+
+// distinct component types for filling an entity manager with many systems
+#define BENCH_TAG(N) \
+    struct BenchTag##N { BenchTag##N() : _value(0) {} qint32 _value; }; \
+    Q_DECLARE_METATYPE(BenchTag##N)
+
+BENCH_TAG(0)  BENCH_TAG(1)  BENCH_TAG(2)  BENCH_TAG(3)
+BENCH_TAG(4)  BENCH_TAG(5)  BENCH_TAG(6)  BENCH_TAG(7)
+BENCH_TAG(8)  BENCH_TAG(9)  BENCH_TAG(10) BENCH_TAG(11)
+BENCH_TAG(12) BENCH_TAG(13) BENCH_TAG(14) BENCH_TAG(15)
+
+#undef BENCH_TAG
+
+static const int NUM_TAG_SYSTEMS = 16;
+
+// add a system for each tag component to entity manager
+inline QVector<EntitySystem*> addTagSystems(EntityManager* em)
+{
+    QVector<EntitySystem*> systems;
+    systems << new SimpleEntitySystem<BenchTag0>(em)  << new SimpleEntitySystem<BenchTag1>(em)
+            << new SimpleEntitySystem<BenchTag2>(em)  << new SimpleEntitySystem<BenchTag3>(em)
+            << new SimpleEntitySystem<BenchTag4>(em)  << new SimpleEntitySystem<BenchTag5>(em)
+            << new SimpleEntitySystem<BenchTag6>(em)  << new SimpleEntitySystem<BenchTag7>(em)
+            << new SimpleEntitySystem<BenchTag8>(em)  << new SimpleEntitySystem<BenchTag9>(em)
+            << new SimpleEntitySystem<BenchTag10>(em) << new SimpleEntitySystem<BenchTag11>(em)
+            << new SimpleEntitySystem<BenchTag12>(em) << new SimpleEntitySystem<BenchTag13>(em)
+            << new SimpleEntitySystem<BenchTag14>(em) << new SimpleEntitySystem<BenchTag15>(em);
+    return systems;
+}
@@ -0,0 +1,350 @@
+#include "benchmark.h"
+#include "components.h"
+
+#include <QtEntity/EntityManager>
+#include <QtEntityScript/JSBindings>
+#include <QtEntityScript/ScriptBindings>
+#include <QtEntityUtils/PrefabSystem>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QJSEngine>
+#include <QScriptEngine>
+#include <qtpropertymanager.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace QtEntity;
+using namespace QtEntityUtils;
+
+// allocations per prefab instance with four components,
+// lower these when the conversion paths get cheaper
+static const double PREFAB_MAP_ALLOCATION_BUDGET = 64;
+static const double PREFAB_BAG_ALLOCATION_BUDGET = 96;
+
+
+// ids 1 to count in random but reproducible order
+QVector<EntityId> shuffledIds(int count)
+{
+    QVector<EntityId> ids(count);
+    std::iota(ids.begin(), ids.end(), EntityId(1));
+    std::mt19937 rng(4711);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    return ids;
+}
+
+
+// create, lookup, iterate, convert and destroy components of a single system
+template <typename System>
+void benchStorage(Benchmark& bench, const QString& backend, System& es, int count)
+{
+    QVector<EntityId> ids = shuffledIds(count);
+
+    bench.run("create", backend, count, [&]() {
+        for(int id = 1; id <= count; ++id)
+        {
+            es.createComponent(id);
+        }
+    });
+
+    bench.run("lookup", backend, count, [&]() {
+        qint64 sum = 0;
+        foreach(EntityId id, ids)
+        {
+            BenchComponent* c;
+            if(es.component(id, c)) sum += c->_value;
+        }
+        s_benchSink += sum;
+    });
+    // typed lookup must not allocate
+    bench.expectAllocations(0);
+
+    bench.run("iterate", backend, count, [&]() {
+        auto end = es.end();
+        for(auto i = es.begin(); i != end; ++i)
+        {
+            i->second->_value += 1;
+        }
+    });
+
+    bench.run("toVariantMap", backend, count, [&]() {
+        qint64 sum = 0;
+        for(int id = 1; id <= count; ++id)
+        {
+            sum += es.toVariantMap(id).size();
+        }
+        s_benchSink += sum;
+    });
+
+    QVariantMap values;
+    values["value"] = 4711;
+    values["x"] = 1.0;
+    values["y"] = 2.0;
+    bench.run("fromVariantMap", backend, count, [&]() {
+        for(int id = 1; id <= count; ++id)
+        {
+            es.fromVariantMap(id, values);
+        }
+    });
+
+    // main thread cost of beginAsyncSave, with conversion and with copies
+    es.setSnapshotConverter(nullptr);
+    bench.run("snapshot convert", backend, count, [&]() {
+        delete es.createSnapshot();
+    });
+    es.setSnapshotConverter(&System::componentToVariantMap);
+    bench.run("snapshot copy", backend, count, [&]() {
+        delete es.createSnapshot();
+    });
+
+    bench.run("destroy random", backend, count, [&]() {
+        foreach(EntityId id, ids)
+        {
+            es.destroyComponent(id);
+        }
+    });
+    bench.expectAllocations(0);
+}
+
+
+// destroy entities that have components in some of many systems
+void benchDestroyEntity(Benchmark& bench, int count)
+{
+    EntityManager em;
+    QVector<EntitySystem*> systems = addTagSystems(&em);
+
+    // each entity has components in a quarter of the systems
+    for(int id = 1; id <= count; ++id)
+    {
+        for(int k = 0; k < NUM_TAG_SYSTEMS; k += 4)
+        {
+            systems[(id + k) % NUM_TAG_SYSTEMS]->createComponent(id);
+        }
+    }
+
+    QVector<EntityId> ids = shuffledIds(count);
+    bench.run("destroyEntity", QString("%1 sys").arg(NUM_TAG_SYSTEMS), count, [&]() {
+        foreach(EntityId id, ids)
+        {
+            em.destroyEntity(id);
+        }
+    });
+}
+
+
+// create entities from a prefab with several components
+void benchPrefabs(Benchmark& bench, int count)
+{
+    EntityManager em;
+    new BenchSimpleSystem(&em);
+    addTagSystems(&em);
+    PrefabSystem* ps = new PrefabSystem(&em);
+
+    QVariantMap component;
+    component["value"] = 1;
+    component["x"] = 2.0;
+    component["y"] = 3.0;
+    QVariantMap components;
+    components["BenchComponent"] = component;
+    components["BenchTag0"] = QVariantMap();
+    components["BenchTag1"] = QVariantMap();
+    components["BenchTag2"] = QVariantMap();
+    ps->addPrefab("bench.prefab", components);
+
+    QVariantMap properties;
+    properties["path"] = "bench.prefab";
+    bench.run("prefab instantiate", "map", count, [&]() {
+        for(int id = 1; id <= count; ++id)
+        {
+            ps->createComponent(id, properties);
+        }
+    });
+    // four components with a node in the index map each,
+    // the rest is variant map conversion
+    bench.expectAllocations(PREFAB_MAP_ALLOCATION_BUDGET);
+
+    PropertyBag bag(properties);
+    bench.run("prefab instantiate", "bag", count, [&]() {
+        for(int id = count + 1; id <= 2 * count; ++id)
+        {
+            ps->createComponentFromBag(id, bag);
+        }
+    });
+    bench.expectAllocations(PREFAB_BAG_ALLOCATION_BUDGET);
+}
+
+
+// property manager storage with properties in groups of 1000
+void benchProperties(Benchmark& bench, int count)
+{
+    QtGroupPropertyManager groups;
+    QtIntPropertyManager ints;
+    QList<QtProperty*> props;
+    bench.run("property create", "manager", count, [&]() {
+        QtProperty* group = nullptr;
+        for(int i = 0; i < count; ++i)
+        {
+            if(i % 1000 == 0)
+            {
+                group = groups.addProperty(QString("group%1").arg(i / 1000));
+                props.push_back(group);
+            }
+            QtProperty* prop = ints.addProperty("value");
+            group->addSubProperty(prop);
+            props.push_back(prop);
+        }
+    });
+
+    bench.run("property update", "manager", count, [&]() {
+        int i = 0;
+        foreach(QtProperty* prop, props)
+        {
+            ints.setValue(prop, ++i);
+        }
+    });
+
+    bench.run("property destroy", "manager", count, [&]() {
+        qDeleteAll(props);
+    });
+
+    // insert leafs and groups with a single call per parent
+    QtProperty* root = groups.addProperty("root");
+    bench.run("property insert", "tree", count, [&]() {
+        QList<QtProperty*> children;
+        for(int i = 0; i < count; i += 100)
+        {
+            QtProperty* group = groups.addProperty(QString("group%1").arg(i / 100));
+            QList<QtProperty*> leafs;
+            for(int j = i; j < qMin(i + 100, count); ++j)
+            {
+                leafs.push_back(ints.addProperty("value"));
+            }
+            group->insertSubProperties(leafs, nullptr);
+            children.push_back(group);
+        }
+        root->insertSubProperties(children, nullptr);
+    });
+}
+
+
+// evaluate the same code with QtScript and QJSEngine bindings,
+// each engine gets an entity manager with a reflected system
+void benchScript(Benchmark& bench, const QString& name, int count, const QString& code, bool withComponent)
+{
+    {
+        EntityManager em;
+        new BenchReflectedSystem(&em);
+        if(withComponent) em.createComponent<BenchReflected>(1);
+        QScriptEngine engine;
+        QtEntityScript::exposeEntityManager(&engine, &em);
+        bench.run(name, "QtScript", count, [&]() {
+            engine.evaluate(code);
+        });
+        if(engine.hasUncaughtException())
+        {
+            fprintf(stderr, "Script error: %s\n", qPrintable(engine.uncaughtException().toString()));
+        }
+    }
+    {
+        EntityManager em;
+        new BenchReflectedSystem(&em);
+        if(withComponent) em.createComponent<BenchReflected>(1);
+        QJSEngine engine;
+        QtEntityScript::exposeEntityManager(&engine, &em);
+        QJSValue ret;
+        bench.run(name, "QJS", count, [&]() {
+            ret = engine.evaluate(code);
+        });
+        if(ret.isError())
+        {
+            fprintf(stderr, "Script error: %s\n", qPrintable(ret.toString()));
+        }
+    }
+}
+
+
+// component access from scripts, count is the number of loop iterations
+void benchScripts(Benchmark& bench, int count)
+{
+    QString n = QString::number(count);
+    benchScript(bench, "script create", count,
+        "for(var i = 1; i <= " + n + "; ++i) EM.BenchReflected.createComponent(i, {value: i});"
+        "for(var i = 1; i <= " + n + "; ++i) EM.BenchReflected.destroyComponent(i);",
+        false);
+    benchScript(bench, "script property", count,
+        "var c = EM.BenchReflected.get(1);"
+        "for(var i = 0; i < " + n + "; ++i) c.value = c.value + 1;",
+        true);
+    benchScript(bench, "script variantmap", count,
+        "for(var i = 0; i < " + n + "; ++i) {"
+        "    var m = EM.BenchReflected.toVariantMap(1);"
+        "    EM.BenchReflected.fromVariantMap(1, {value: m.value + 1});"
+        "}",
+        true);
+}
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks for QtEntity storage and entity manager operations");
+    parser.addHelpOption();
+    QCommandLineOption minOption("min", "Smallest number of components.", "count", "1000");
+    QCommandLineOption maxOption("max", "Largest number of components.", "count", "10000000");
+    QCommandLineOption managerMaxOption("manager-max", "Largest number of entities for entity manager, prefab, property and script benchmarks.", "count", "1000000");
+    QCommandLineOption outputOption("output", "Write JSON results to this file.", "path", "qtentity_bench.json");
+    parser.addOption(minOption);
+    parser.addOption(maxOption);
+    parser.addOption(managerMaxOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    int mincount = qMax(1, parser.value(minOption).toInt());
+    int maxcount = parser.value(maxOption).toInt();
+    int managermax = parser.value(managerMaxOption).toInt();
+
+    Benchmark bench;
+
+    // counts grow by factor 10
+    for(int count = mincount; count <= maxcount; count *= 10)
+    {
+        {
+            EntityManager em;
+            BenchSimpleSystem* es = new BenchSimpleSystem(&em);
+            benchStorage(bench, "simple", *es, count);
+        }
+        {
+            // grow in 16 steps, pooled storage grows by fixed chunks
+            EntityManager em;
+            BenchPooledSystem* es = new BenchPooledSystem(&em, size_t(0), size_t(qMax(count / 16, 64)));
+            benchStorage(bench, "pooled", *es, count);
+        }
+        if(count > maxcount / 10) break;
+    }
+
+    for(int count = mincount; count <= managermax; count *= 10)
+    {
+        benchDestroyEntity(bench, count);
+        benchPrefabs(bench, count);
+        benchProperties(bench, count);
+        benchScripts(bench, count);
+        if(count > managermax / 10) break;
+    }
+
+    QString path = parser.value(outputOption);
+    if(!bench.writeJson(path))
+    {
+        fprintf(stderr, "Could not write results to %s\n", qPrintable(path));
+        return 1;
+    }
+    printf("Results written to %s\n", qPrintable(path));
+
+    if(!bench.failures().isEmpty())
+    {
+        fprintf(stderr, "%d allocation budgets exceeded\n", bench.failures().size());
+        return 1;
+    }
+    return 0;
+}
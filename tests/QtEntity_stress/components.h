@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QtEntity/PooledEntitySystem>
+#include <QtEntity/ReflectedEntitySystem>
+#include <QtEntity/SimpleEntitySystem>
+
+using namespace QtEntity;
+
+
+// number of stress components currently constructed and not destructed
+inline qint64& liveComponents()
+{
+    static qint64 live = 0;
+    return live;
+}
+
+
+// number of destructor calls on components that were already destructed
+inline qint64& badDestructions()
+{
+    static qint64 bad = 0;
+    return bad;
+}
+
+
+/**
+ * Component that tracks its own lifetime. Destructing a component twice,
+ * or reading a slot that does not hold a constructed component,
+ * is visible through the magic value.
+ */
+class StressComponent
+{
+    Q_GADGET
+    Q_PROPERTY(qint64 value MEMBER _value)
+
+public:
+
+    static const quint32 ALIVE = 0x5a11ce;
+    static const quint32 DEAD  = 0xdead;
+
+    StressComponent()
+        : _value(0)
+        , _magic(ALIVE)
+    {
+        ++liveComponents();
+    }
+
+    StressComponent(const StressComponent& other)
+        : _value(other._value)
+        , _magic(ALIVE)
+    {
+        ++liveComponents();
+    }
+
+    ~StressComponent()
+    {
+        if(_magic != ALIVE) ++badDestructions();
+        _magic = DEAD;
+        --liveComponents();
+    }
+
+    StressComponent& operator=(const StressComponent& other)
+    {
+        _value = other._value;
+        return *this;
+    }
+
+    bool isAlive() const { return _magic == ALIVE; }
+
+    qint64 _value;
+    quint32 _magic;
+};
+
+Q_DECLARE_METATYPE(StressComponent)
+
+typedef SimpleEntitySystem<StressComponent> StressSimpleSystem;
+typedef PooledEntitySystem<StressComponent> StressPooledSystem;
+typedef ReflectedEntitySystem<StressComponent> StressReflectedSystem;
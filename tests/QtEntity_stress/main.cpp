@@ -0,0 +1,441 @@
+#include "components.h"
+
+#include <QtEntity/EntityManager>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+struct StressOptions
+{
+    quint64 _ops;
+    EntityId _ids;
+    int _bulk;
+    quint32 _seed;
+    quint64 _checkInterval;
+};
+
+
+/**
+ * Applies random operations to an entity system and to a reference model
+ * and compares the system with the model after each operation.
+ * Invariants of the whole system are checked periodically.
+ * Stops at the first difference and prints it.
+ */
+template <typename System>
+class StressRun
+{
+public:
+
+    /**
+     * @param viaVariants Write and read components through fromVariantMap and
+     *                    toVariantMap in addition to typed access
+     */
+    StressRun(const QString& backend, System& es, const StressOptions& options, bool viaVariants)
+        : _backend(backend)
+        , _es(es)
+        , _options(options)
+        , _viaVariants(viaVariants)
+        , _rng(options._seed)
+        , _ops(0)
+        , _failed(false)
+    {
+    }
+
+    bool failed() const { return _failed; }
+    quint64 ops() const { return _ops; }
+
+    /**
+     * Random interleaved operations on entity ids 1 to options._ids
+     */
+    void runRandom()
+    {
+        _phase = "random";
+        std::uniform_int_distribution<EntityId> idDist(1, _options._ids);
+        std::uniform_int_distribution<int> opDist(0, 99999);
+        for(quint64 i = 0; i < _options._ops && !_failed; ++i)
+        {
+            int r = opDist(_rng);
+            EntityId id = idDist(_rng);
+            if(r < 35000)      create(id);
+            else if(r < 60000) destroy(id);
+            else if(r < 85000) lookup(id);
+            else if(r < 99790) update(id);
+            else if(r < 99999) eraseDuringIteration(4);
+            else               clear();
+
+            if(i % _options._checkInterval == 0) checkInvariants();
+        }
+        checkInvariants();
+    }
+
+    /**
+     * Fill the system with options._bulk components, destroy half of them
+     * in random order, erase a third of the rest while iterating, then clear
+     */
+    void runBulk()
+    {
+        _phase = "bulk";
+        std::vector<EntityId> ids(_options._bulk);
+        std::iota(ids.begin(), ids.end(), EntityId(1));
+        std::shuffle(ids.begin(), ids.end(), _rng);
+
+        for(auto i = ids.begin(); i != ids.end() && !_failed; ++i)
+        {
+            create(*i);
+        }
+        checkInvariants();
+
+        std::shuffle(ids.begin(), ids.end(), _rng);
+        for(size_t i = 0; i < ids.size() / 2 && !_failed; ++i)
+        {
+            destroy(ids[i]);
+        }
+        checkInvariants();
+
+        eraseDuringIteration(3);
+        checkInvariants();
+
+        clear();
+        checkInvariants();
+    }
+
+private:
+
+    void fail(const QString& msg)
+    {
+        if(_failed) return;
+        _failed = true;
+        fprintf(stderr, "FAILED %s %s after %llu operations (seed %u): %s\n",
+                qPrintable(_backend), qPrintable(_phase), (unsigned long long)_ops,
+                _options._seed, qPrintable(msg));
+    }
+
+    void create(EntityId id)
+    {
+        ++_ops;
+        bool existed = _model.find(id) != _model.end();
+        qint64 value = qint64(_rng());
+
+        void* obj;
+        if(_viaVariants && (value & 1))
+        {
+            QVariantMap m;
+            m["value"] = value;
+            obj = _es.createComponent(id, m);
+        }
+        else
+        {
+            obj = _es.createComponent(id);
+            if(obj != nullptr) static_cast<StressComponent*>(obj)->_value = value;
+        }
+
+        if(existed)
+        {
+            if(obj != nullptr) fail(QString("created second component for %1").arg(id));
+            return;
+        }
+        if(obj == nullptr)
+        {
+            fail(QString("could not create component for %1").arg(id));
+            return;
+        }
+        StressComponent* c = static_cast<StressComponent*>(obj);
+        if(!c->isAlive() || c->_value != value)
+        {
+            fail(QString("new component of %1 has wrong state").arg(id));
+            return;
+        }
+        _model[id] = value;
+    }
+
+    void destroy(EntityId id)
+    {
+        ++_ops;
+        bool destroyed = _es.destroyComponent(id);
+        bool existed = _model.erase(id) != 0;
+        if(destroyed != existed)
+        {
+            fail(QString("destroyComponent(%1) returned %2").arg(id).arg(destroyed));
+        }
+    }
+
+    void lookup(EntityId id)
+    {
+        ++_ops;
+        StressComponent* c;
+        bool found = _es.component(id, c);
+        auto i = _model.find(id);
+        if(found != (i != _model.end()))
+        {
+            fail(QString("component(%1) returned %2").arg(id).arg(found));
+            return;
+        }
+        if(!found) return;
+        if(!c->isAlive() || c->_value != i->second)
+        {
+            fail(QString("component of %1 has wrong state").arg(id));
+            return;
+        }
+        if(_viaVariants && _es.toVariantMap(id)["value"].toLongLong() != i->second)
+        {
+            fail(QString("toVariantMap(%1) returned wrong value").arg(id));
+        }
+    }
+
+    void update(EntityId id)
+    {
+        ++_ops;
+        auto i = _model.find(id);
+        if(i == _model.end()) return;
+
+        StressComponent* c;
+        if(!_es.component(id, c))
+        {
+            fail(QString("component of %1 is missing").arg(id));
+            return;
+        }
+        qint64 value = qint64(_rng());
+        if(_viaVariants && (value & 1))
+        {
+            QVariantMap m;
+            m["value"] = value;
+            _es.fromVariantMap(id, m);
+        }
+        else
+        {
+            c->_value = value;
+        }
+        i->second = value;
+    }
+
+    // iterate all components and erase one in eraseOneIn of them.
+    // Every component has to be visited exactly once.
+    void eraseDuringIteration(int eraseOneIn)
+    {
+        ++_ops;
+        size_t expected = _model.size();
+        std::unordered_set<EntityId> visited;
+        visited.reserve(expected);
+        std::uniform_int_distribution<int> dist(0, eraseOneIn - 1);
+
+        for(auto i = _es.begin(); i != _es.end();)
+        {
+            EntityId id = i->first;
+            if(!visited.insert(id).second)
+            {
+                fail(QString("visited %1 twice while erasing").arg(id));
+                return;
+            }
+            auto m = _model.find(id);
+            if(m == _model.end() || !i->second->isAlive() || i->second->_value != m->second)
+            {
+                fail(QString("visited component of %1 with wrong state while erasing").arg(id));
+                return;
+            }
+            if(dist(_rng) == 0)
+            {
+                i = _es.erase(i);
+                _model.erase(m);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        if(visited.size() != expected)
+        {
+            fail(QString("visited %1 of %2 components while erasing").arg(visited.size()).arg(expected));
+        }
+    }
+
+    void clear()
+    {
+        ++_ops;
+        _es.clear();
+        _model.clear();
+    }
+
+    void checkInvariants()
+    {
+        if(_failed) return;
+
+        if(_es.count() != _model.size())
+        {
+            fail(QString("count() is %1, expected %2").arg(_es.count()).arg(_model.size()));
+            return;
+        }
+
+        // every component constructed by the system is either stored or destructed
+        if(liveComponents() != qint64(_es.count()))
+        {
+            fail(QString("%1 components alive, system holds %2").arg(liveComponents()).arg(_es.count()));
+            return;
+        }
+        if(badDestructions() != 0)
+        {
+            fail(QString("%1 components destructed twice").arg(badDestructions()));
+            return;
+        }
+
+        // iterated ids are in the model and the index of each one points to its slot.
+        // Together with the count check this makes index and storage equal to the model
+        size_t n = 0;
+        for(auto i = _es.begin(); i != _es.end(); ++i, ++n)
+        {
+            EntityId id = i->first;
+            StressComponent* c = i->second;
+            if(_es.component(id) != c)
+            {
+                fail(QString("index of %1 does not point to its slot").arg(id));
+                return;
+            }
+            auto m = _model.find(id);
+            if(m == _model.end())
+            {
+                fail(QString("component of %1 should not exist").arg(id));
+                return;
+            }
+            if(!c->isAlive() || c->_value != m->second)
+            {
+                fail(QString("component of %1 has wrong state").arg(id));
+                return;
+            }
+        }
+        if(n != _model.size())
+        {
+            fail(QString("iterated %1 of %2 components").arg(n).arg(_model.size()));
+            return;
+        }
+
+        size_t pn = 0;
+        for(auto i = _es.pbegin(); i != _es.pend(); ++i, ++pn)
+        {
+            if(!static_cast<StressComponent*>(*i)->isAlive())
+            {
+                fail("polymorphic iterator returned destructed component");
+                return;
+            }
+        }
+        if(pn != _model.size())
+        {
+            fail(QString("polymorphic iterators visited %1 of %2 components").arg(pn).arg(_model.size()));
+            return;
+        }
+
+        if(_es.memoryStats()._count != _model.size())
+        {
+            fail("memoryStats() reports wrong count");
+        }
+    }
+
+    QString _backend;
+    QString _phase;
+    System& _es;
+    StressOptions _options;
+    bool _viaVariants;
+    std::mt19937 _rng;
+    std::unordered_map<EntityId, qint64> _model;
+    quint64 _ops;
+    bool _failed;
+};
+
+
+static void report(const QString& backend, const char* phase, quint64 ops, qint64 nsecs)
+{
+    printf("%-10s %-7s %12llu ops %10.3f s %12.0f ops/s\n",
+           qPrintable(backend), phase, (unsigned long long)ops, double(nsecs) / 1e9,
+           double(ops) * 1e9 / double(qMax(nsecs, qint64(1))));
+    fflush(stdout);
+}
+
+
+// run random and bulk phase against a fresh system each,
+// create is called with the entity manager and a chunk size for pooled storage
+template <typename System, typename Factory>
+bool stressBackend(const QString& backend, const StressOptions& options, bool viaVariants, Factory create)
+{
+    bool ok = true;
+    for(int phase = 0; phase < 2 && ok; ++phase)
+    {
+        {
+            EntityManager em;
+            size_t chunk = (phase == 0) ? 16 : size_t(qMax(options._bulk / 16, 64));
+            System* es = create(&em, chunk);
+            StressRun<System> run(backend, *es, options, viaVariants);
+
+            QElapsedTimer timer;
+            timer.start();
+            if(phase == 0)
+            {
+                run.runRandom();
+            }
+            else
+            {
+                run.runBulk();
+            }
+            report(backend, phase == 0 ? "random" : "bulk", run.ops(), timer.nsecsElapsed());
+            ok = !run.failed();
+        }
+
+        // entity manager destroyed the system and all of its components
+        if(ok && (liveComponents() != 0 || badDestructions() != 0))
+        {
+            fprintf(stderr, "FAILED %s: %lld components alive and %lld destructed twice after deleting system\n",
+                    qPrintable(backend), (long long)liveComponents(), (long long)badDestructions());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Randomized stress test of QtEntity storage backends against a reference model");
+    parser.addHelpOption();
+    QCommandLineOption opsOption("ops", "Number of random operations per backend.", "count", "2000000");
+    QCommandLineOption idsOption("ids", "Random operations use entity ids from 1 to this.", "count", "4096");
+    QCommandLineOption bulkOption("bulk", "Number of components in bulk phase.", "count", "1000000");
+    QCommandLineOption seedOption("seed", "Random seed, print by failures to reproduce them.", "seed", "4711");
+    QCommandLineOption checkOption("check-interval", "Check all invariants after this many random operations.", "count", "10000");
+    parser.addOption(opsOption);
+    parser.addOption(idsOption);
+    parser.addOption(bulkOption);
+    parser.addOption(seedOption);
+    parser.addOption(checkOption);
+    parser.process(app);
+
+    StressOptions options;
+    options._ops = parser.value(opsOption).toULongLong();
+    options._ids = qMax(1u, parser.value(idsOption).toUInt());
+    options._bulk = qMax(1, parser.value(bulkOption).toInt());
+    options._seed = parser.value(seedOption).toUInt();
+    options._checkInterval = qMax(1ull, parser.value(checkOption).toULongLong());
+
+    printf("seed %u\n", options._seed);
+
+    bool ok = true;
+    ok = stressBackend<StressSimpleSystem>("simple", options, false, [](EntityManager* em, size_t) {
+        return new StressSimpleSystem(em);
+    }) && ok;
+    ok = stressBackend<StressPooledSystem>("pooled", options, false, [](EntityManager* em, size_t chunk) {
+        return new StressPooledSystem(em, size_t(0), chunk);
+    }) && ok;
+    ok = stressBackend<StressReflectedSystem>("reflected", options, true, [](EntityManager* em, size_t chunk) {
+        return new StressReflectedSystem(em, size_t(0), chunk);
+    }) && ok;
+
+    return ok ? 0 : 1;
+}
@@ -1,11 +1,11 @@
 #pragma once
 
 #include <QtEntity/EntityManager>
+#include <QtEntity/ReflectedEntitySystem>
 #include <QtEntity/SimpleEntitySystem>
 #include <QtEntity/DataTypes>
 #include <QtCore/QObject>
 #include <QtGui/QColor>
-#include <QScriptable>
 
 using namespace QtEntity;
 
@@ -96,13 +96,25 @@ public:
 };
 
 
-class EntitySystemPrototype : public QObject, public QScriptable
+class ReflectedTesting
 {
-    Q_OBJECT
+    Q_GADGET
+    Q_PROPERTY(qint32 myint MEMBER _myint)
+    Q_PROPERTY(QColor mycolor READ myColor WRITE setMyColor)
+    Q_PROPERTY(QString mytransient MEMBER _mytransient STORED false)
+
 public:
-    EntitySystemPrototype(QObject *parent = 0);
-    
-    Q_INVOKABLE bool createComponent(QtEntity::EntityId id, const QVariantMap& params);
-    Q_INVOKABLE bool destroyComponent(QtEntity::EntityId id);
-    Q_INVOKABLE quint32 count() const;
+
+    ReflectedTesting() : _myint(0) {}
+
+    void setMyColor(const QColor& v) { _mycolor = v; }
+    QColor myColor() const  { return _mycolor; }
+
+    qint32 _myint;
+    QColor _mycolor;
+    QString _mytransient;
 };
+
+Q_DECLARE_METATYPE(ReflectedTesting)
+
+typedef ReflectedEntitySystem<ReflectedTesting> ReflectedTestingSystem;
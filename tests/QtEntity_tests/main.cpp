@@ -1,14 +1,23 @@
 #include <QtTest/QtTest>
+#include <QApplication>
 
+#include "test_allocations.h"
+#include "test_editjournal.h"
+#include "test_entitylistmodel.h"
 #include "test_entitymanager.h"
 #include "test_entitysystem.h"
+#include "test_modelpropertybrowser.h"
 #include "test_pooledentitysystem.h"
 #include "test_prefabsystem.h"
+#include "test_profiler.h"
+#include "test_propertymanager.h"
+#include "test_scriptengines.h"
 #include "test_scripting.h"
 
 int main(int argc, char *argv[])
 {
-    QCoreApplication app(argc, argv);
+    // property browser tests need a widget application
+    QApplication app(argc, argv);
     app.setAttribute(Qt::AA_Use96Dpi, true);
 
     { EntitySystemTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
@@ -16,6 +25,13 @@ int main(int argc, char *argv[])
     { PooledEntitySystemTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
     { PrefabSystemTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
     { ScriptingTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
+    { ScriptEnginesTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
+    { EditJournalTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
+    { EntityListModelTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
+    { ProfilerTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
+    { AllocationTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
+    { PropertyManagerTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
+    { ModelPropertyBrowserTest t; if(0 != QTest::qExec(&t, argc, argv)) return 1; }
 
     return 0;
 }
@@ -0,0 +1,107 @@
+#include <QtTest/QtTest>
+#include <QtCore/QObject>
+#include <QtEntity/EntityManager>
+#include <QtEntity/PooledEntitySystem>
+#include <QtEntityUtils/PrefabSystem>
+#include "allocationtracker.h"
+#include "common.h"
+
+using namespace QtEntity;
+using namespace QtEntityUtils;
+
+
+// Allocation budgets of hot paths. Run with QTENTITY_TRACK_ALLOCATIONS,
+// otherwise all tests are skipped.
+class AllocationTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void initTestCase()
+    {
+        if(!AllocationTracker::isAvailable())
+        {
+            QSKIP("Built without QTENTITY_TRACK_ALLOCATIONS");
+        }
+    }
+
+    void trackerCounts()
+    {
+        AllocationScope scope;
+        QVector<qint32> v(100);
+        AllocationCount c = scope.count();
+        QCOMPARE(v.size(), 100);
+        QVERIFY(c._allocations >= 1);
+        QVERIFY(c._bytes >= 100 * sizeof(qint32));
+    }
+
+    void typedLookup()
+    {
+        EntityManager em;
+        TestingSystem* simple = new TestingSystem(&em);
+
+        EntityManager em2;
+        PooledEntitySystem<Testing>* pooled = new PooledEntitySystem<Testing>(&em2);
+
+        for(EntityId id = 1; id <= 100; ++id)
+        {
+            simple->createComponent(id);
+            pooled->createComponent(id);
+        }
+
+        // first call registers the meta type
+        em.component<Testing>(1);
+
+        int found = 0;
+        AllocationScope scope;
+        for(EntityId id = 1; id <= 100; ++id)
+        {
+            Testing* t;
+            if(simple->component(id, t)) ++found;
+            if(pooled->component(id, t)) ++found;
+            if(em.component<Testing>(id) != nullptr) ++found;
+            if(em2.component(id, t)) ++found;
+        }
+        AllocationCount c = scope.count();
+
+        QCOMPARE(found, 400);
+        QCOMPARE(c._allocations, quint64(0));
+    }
+
+    void prefabInstantiation()
+    {
+        EntityManager em;
+        PrefabSystem* ps = new PrefabSystem(&em);
+        new TestingSystem(&em);
+
+        QVariantMap mycomponent;
+        mycomponent["myint"] = 12345;
+        QVariantMap components;
+        components["Testing"] = mycomponent;
+        ps->addPrefab("budget.prefab", components);
+
+        QVariantMap props;
+        props["path"] = "budget.prefab";
+
+        // warm up lookup tables and meta types
+        ps->createComponent(1, props);
+
+        const int count = 100;
+        AllocationScope scope;
+        for(EntityId id = 2; id < count + 2; ++id)
+        {
+            ps->createComponent(id, props);
+        }
+        AllocationCount c = scope.count();
+
+        QCOMPARE(em.component<Testing>(count + 1)->myInt(), 12345);
+
+        // two components, each with a heap block and an index node,
+        // plus variant map conversion. Lower when conversion gets cheaper.
+        const quint64 budgetPerInstance = 32;
+        QVERIFY2(c._allocations <= budgetPerInstance * count,
+                 qPrintable(QString("%1 allocations per prefab instance, budget is %2")
+                            .arg(double(c._allocations) / count).arg(budgetPerInstance)));
+    }
+};
@@ -0,0 +1,274 @@
+#include <QtTest/QtTest>
+#include <QtCore/QObject>
+#include <QtEntity/EntityManager>
+#include <QtEntityUtils/EditJournal>
+#include <QtEntityUtils/EntityEditor>
+#include "common.h"
+
+using namespace QtEntity;
+using namespace QtEntityUtils;
+
+
+class EditJournalTest: public QObject
+{
+    Q_OBJECT
+
+private:
+
+    // apply a value to Testing component of given entity, recorded in journal
+    void setMyInt(EntityManager& em, EntityId id, int v, EditJournal& journal)
+    {
+        QVariantMap testing;
+        testing["myint"] = v;
+        QVariantMap values;
+        values["Testing"] = testing;
+        EntityEditor::applyEntityData(em, id, values, &journal);
+    }
+
+private slots:
+
+    void undoRedo()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QVariantMap m;
+        m["myint"] = 1;
+        m["mycolor"] = QColor(Qt::red);
+        Testing* t = static_cast<Testing*>(em.createComponent(1, qMetaTypeId<Testing>(), m));
+
+        EditJournal journal;
+        QVERIFY(!journal.canUndo());
+        setMyInt(em, 1, 2, journal);
+        setMyInt(em, 1, 3, journal);
+        QCOMPARE(journal.size(), 2);
+        QCOMPARE(t->myInt(), 3);
+
+        // only touched field is re-applied
+        t->setMyColor(QColor(Qt::blue));
+
+        QVERIFY(journal.undo(em));
+        QCOMPARE(t->myInt(), 2);
+        QVERIFY(journal.undo(em));
+        QCOMPARE(t->myInt(), 1);
+        QVERIFY(!journal.undo(em));
+        QCOMPARE(t->myColor(), QColor(Qt::blue));
+
+        QVERIFY(journal.redo(em));
+        QCOMPARE(t->myInt(), 2);
+
+        // new edit discards redo entries
+        setMyInt(em, 1, 5, journal);
+        QVERIFY(!journal.canRedo());
+        QCOMPARE(journal.size(), 2);
+    }
+
+    void batch()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QVariantMap m;
+        m["myint"] = 1;
+        Testing* t1 = static_cast<Testing*>(em.createComponent(1, qMetaTypeId<Testing>(), m));
+        Testing* t2 = static_cast<Testing*>(em.createComponent(2, qMetaTypeId<Testing>(), m));
+
+        EditJournal journal;
+        journal.beginBatch();
+        setMyInt(em, 1, 10, journal);
+        setMyInt(em, 2, 20, journal);
+        setMyInt(em, 2, 30, journal);
+        journal.endBatch();
+        QCOMPARE(journal.size(), 1);
+
+        QVERIFY(journal.undo(em));
+        QCOMPARE(t1->myInt(), 1);
+        QCOMPARE(t2->myInt(), 1);
+        QVERIFY(journal.redo(em));
+        QCOMPARE(t1->myInt(), 10);
+        QCOMPARE(t2->myInt(), 30);
+    }
+
+    void noOpEdits()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QVariantMap m;
+        m["myint"] = 1;
+        em.createComponent(1, qMetaTypeId<Testing>(), m);
+
+        // setting the current value is not recorded
+        EditJournal journal;
+        setMyInt(em, 1, 1, journal);
+        QCOMPARE(journal.size(), 0);
+
+        // neither is a batch whose changes cancel out
+        journal.beginBatch();
+        setMyInt(em, 1, 5, journal);
+        setMyInt(em, 1, 1, journal);
+        journal.endBatch();
+        QCOMPARE(journal.size(), 0);
+        QVERIFY(!journal.canUndo());
+    }
+
+    void multiEntity()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        new ReflectedTestingSystem(&em);
+        QVariantMap m;
+        m["myint"] = 1;
+        m["mycolor"] = QColor(Qt::red);
+        Testing* t1 = em.createComponent<Testing>(1, m);
+        Testing* t2 = em.createComponent<Testing>(2, m);
+        ReflectedTesting* r1 = em.createComponent<ReflectedTesting>(1, m);
+        m["myint"] = 2;
+        ReflectedTesting* r2 = em.createComponent<ReflectedTesting>(2, m);
+
+        // only differing fields are marked as mixed
+        QList<EntityId> ids;
+        ids << 1 << 2;
+        QVariantMap components, attributes;
+        QStringList available;
+        EntityEditor::fetchEntitiesData(em, ids, components, attributes, available);
+        QCOMPARE(components.size(), 2);
+        QVariantMap reflectedAttrs = attributes["ReflectedTesting"].toMap();
+        QVERIFY(reflectedAttrs["myint"].toMap()["mixed"].toBool());
+        QVERIFY(!reflectedAttrs["mycolor"].toMap().contains("mixed"));
+        QVERIFY(!attributes["Testing"].toMap()["myint"].toMap().contains("mixed"));
+
+        QVariantMap values;
+        values["myint"] = 10;
+        QVariantMap data;
+        data["Testing"] = values;
+        data["ReflectedTesting"] = values;
+        EditJournal journal;
+        EntityEditor::applyEntitiesData(em, ids, data, &journal);
+        QCOMPARE(journal.size(), 1);
+        QCOMPARE(t1->myInt(), 10);
+        QCOMPARE(t2->myInt(), 10);
+        QCOMPARE(r1->_myint, 10);
+        QCOMPARE(r2->_myint, 10);
+        QCOMPARE(r2->myColor(), QColor(Qt::red));
+
+        QVERIFY(journal.undo(em));
+        QCOMPARE(t2->myInt(), 1);
+        QCOMPARE(r1->_myint, 1);
+        QCOMPARE(r2->_myint, 2);
+    }
+
+    void multiEntityPatch()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QVariantMap m;
+        m["myobjects"] = QVariantList() << 1 << 2;
+        Testing* t1 = static_cast<Testing*>(em.createComponent(1, qMetaTypeId<Testing>(), m));
+        m["myobjects"] = QVariantList() << 3 << 4;
+        Testing* t2 = static_cast<Testing*>(em.createComponent(2, qMetaTypeId<Testing>(), m));
+
+        // differing list entries are marked as mixed
+        QList<EntityId> ids;
+        ids << 1 << 2;
+        QVariantMap components, attributes;
+        QStringList available;
+        EntityEditor::fetchEntitiesData(em, ids, components, attributes, available);
+        QVERIFY(attributes["Testing"].toMap()["myobjects"].toMap()["mixed"].toBool());
+
+        // only the patched entry is changed, other entries keep their value per entity
+        EditJournal journal;
+        EntityEditor::applyEntitiesPatch(em, ids, "Testing", "myobjects[0]", 10, &journal);
+        QCOMPARE(journal.size(), 1);
+        QCOMPARE(t1->myObjects(), QVariantList() << 10 << 2);
+        QCOMPARE(t2->myObjects(), QVariantList() << 10 << 4);
+
+        QVERIFY(journal.undo(em));
+        QCOMPARE(t1->myObjects(), QVariantList() << 1 << 2);
+        QCOMPARE(t2->myObjects(), QVariantList() << 3 << 4);
+    }
+
+    void ringBuffer()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QVariantMap m;
+        m["myint"] = 0;
+        Testing* t = static_cast<Testing*>(em.createComponent(1, qMetaTypeId<Testing>(), m));
+
+        EditJournal journal(4);
+        for(int i = 1; i <= 10; ++i)
+        {
+            setMyInt(em, 1, i, journal);
+        }
+        QCOMPARE(journal.size(), 4);
+        qint64 datasize = journal.dataSize();
+        setMyInt(em, 1, 11, journal);
+        QCOMPARE(journal.dataSize(), datasize);
+
+        while(journal.undo(em)) {}
+        QCOMPARE(t->myInt(), 7);
+
+        journal.setCapacity(2);
+        QCOMPARE(journal.size(), 2);
+        QVERIFY(journal.redo(em));
+        QVERIFY(journal.redo(em));
+        QVERIFY(!journal.redo(em));
+        QCOMPARE(t->myInt(), 11);
+    }
+
+    void dataSizeLimit()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QVariantMap m;
+        m["myint"] = 0;
+        Testing* t = static_cast<Testing*>(em.createComponent(1, qMetaTypeId<Testing>(), m));
+
+        EditJournal journal(100);
+        setMyInt(em, 1, 1, journal);
+        qint64 entrysize = journal.dataSize();
+        journal.setMaxDataSize(3 * entrysize);
+        for(int i = 2; i <= 10; ++i)
+        {
+            setMyInt(em, 1, i, journal);
+        }
+        QCOMPARE(journal.size(), 3);
+        QVERIFY(journal.dataSize() <= journal.maxDataSize());
+
+        while(journal.undo(em)) {}
+        QCOMPARE(t->myInt(), 7);
+
+        // newest entry is kept even if it exceeds the limit
+        journal.setMaxDataSize(1);
+        QCOMPARE(journal.size(), 1);
+    }
+
+    void batchManyChanges()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QVariantMap m;
+        m["myint"] = 0;
+        const int count = 1000;
+        for(EntityId id = 1; id <= count; ++id)
+        {
+            em.createComponent(id, qMetaTypeId<Testing>(), m);
+        }
+
+        // changes of the same field are merged, one change per entity remains
+        EditJournal journal;
+        journal.beginBatch();
+        for(int i = 1; i <= 3; ++i)
+        {
+            for(EntityId id = 1; id <= count; ++id)
+            {
+                setMyInt(em, id, i, journal);
+            }
+        }
+        journal.endBatch();
+        QCOMPARE(journal.size(), 1);
+
+        QVERIFY(journal.undo(em));
+        QCOMPARE(em.component<Testing>(count)->myInt(), 0);
+        QVERIFY(journal.redo(em));
+        QCOMPARE(em.component<Testing>(count)->myInt(), 3);
+    }
+};
@@ -0,0 +1,105 @@
+#include <QtTest/QtTest>
+#include <QtCore/QObject>
+#include <QtEntity/EntityManager>
+#include <QtEntityUtils/EntityListModel>
+#include "common.h"
+
+using namespace QtEntity;
+using namespace QtEntityUtils;
+
+
+class EntityListModelTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void refresh()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        new ReflectedTestingSystem(&em);
+        em.createComponent<Testing>(1);
+        em.createComponent<Testing>(2);
+        ReflectedTesting* r = em.createComponent<ReflectedTesting>(2);
+        r->_mytransient = "Second";
+
+        EntityListModel model(&em);
+        QCOMPARE(model.rowCount(), 2);
+        QCOMPARE(model.entityId(model.index(0, 0)), EntityId(1));
+        QCOMPARE(model.data(model.index(1, EntityListModel::ComponentsColumn)).toString().split(", ").size(), 2);
+
+        model.setNameField("ReflectedTesting", "mytransient");
+        model.refresh();
+        QCOMPARE(model.data(model.index(1, EntityListModel::NameColumn)).toString(), QString("Second"));
+    }
+
+    void filter()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        new ReflectedTestingSystem(&em);
+        for(EntityId id = 1; id <= 100; ++id)
+        {
+            em.createComponent<Testing>(id);
+            if(id % 10 == 0)
+            {
+                ReflectedTesting* r = em.createComponent<ReflectedTesting>(id);
+                r->_mytransient = QString("Entity %1").arg(id);
+            }
+        }
+
+        EntityListModel model(&em);
+        model.setNameField("ReflectedTesting", "mytransient");
+        model.refresh();
+        QCOMPARE(model.rowCount(), 100);
+
+        model.setComponentFilter(QStringList() << "ReflectedTesting");
+        QCOMPARE(model.rowCount(), 10);
+        model.setNameFilter("entity 5");
+        QCOMPARE(model.rowCount(), 1);
+        QCOMPARE(model.entityId(model.index(0, 0)), EntityId(50));
+        QVERIFY(!model.indexOf(40).isValid());
+
+        model.setNameFilter(QString());
+        model.setComponentFilter(QStringList() << "Unknown");
+        QCOMPARE(model.rowCount(), 0);
+        model.setComponentFilter(QStringList());
+        QCOMPARE(model.rowCount(), 100);
+    }
+
+    void batchedEvents()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        for(EntityId id = 1; id <= 10; ++id)
+        {
+            em.createComponent<Testing>(id);
+        }
+        EntityListModel model(&em);
+        QSignalSpy inserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+        QSignalSpy removed(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
+        // changes are only applied on flush
+        for(EntityId id = 11; id <= 20; ++id)
+        {
+            em.createComponent<Testing>(id);
+            model.entityChanged(id);
+        }
+        em.destroyComponent<Testing>(3);
+        em.destroyComponent<Testing>(4);
+        em.destroyComponent<Testing>(8);
+        model.entityChanged(3);
+        model.entityChanged(4);
+        model.entityChanged(8);
+        QCOMPARE(model.rowCount(), 10);
+
+        model.flush();
+        QCOMPARE(model.rowCount(), 17);
+        QCOMPARE(model.entityCount(), 17);
+        QCOMPARE(inserted.count(), 1);
+        QCOMPARE(removed.count(), 2);
+        QCOMPARE(model.indexOf(20).row(), 16);
+        QVERIFY(!model.indexOf(3).isValid());
+    }
+};
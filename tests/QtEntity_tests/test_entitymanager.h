@@ -2,11 +2,41 @@
 #include <QtCore/QObject>
 #include <QtEntity/EntityManager>
 #include <QtEntity/SimpleEntitySystem>
+#include <QTemporaryDir>
+#include <memory>
 #include "common.h"
 
 using namespace QtEntity;
 
 
+// snapshot converter for Testing components
+static QVariantMap testingToVariantMap(const Testing& t, int)
+{
+    QVariantMap m;
+    m["myint"] = t.myInt();
+    return m;
+}
+
+
+// remembers the conversion contexts of non-empty fromVariantMap calls
+class ContextRecordingSystem : public TestingSystem
+{
+public:
+    ContextRecordingSystem(EntityManager* em)
+        : TestingSystem(em)
+    {
+    }
+
+    virtual void fromVariantMap(QtEntity::EntityId eid, const QVariantMap& m, int context = 0) override
+    {
+        if(!m.isEmpty()) _contexts.append(context);
+        TestingSystem::fromVariantMap(eid, m, context);
+    }
+
+    QList<int> _contexts;
+};
+
+
 class EntityManagerTest: public QObject
 {
     Q_OBJECT
@@ -110,4 +140,128 @@ private slots:
     }
 
 
+    void internFieldNames()
+    {
+        FieldId a = FieldNames::intern("internTestA");
+        FieldId b = FieldNames::intern("internTestB");
+        QVERIFY(a != b);
+        QCOMPARE(FieldNames::intern("internTestA"), a);
+        QCOMPARE(FieldNames::find("internTestB"), b);
+        QCOMPARE(FieldNames::find("internTestNeverInterned"), FieldNames::INVALID);
+        QCOMPARE(FieldNames::name(a), QString("internTestA"));
+    }
+
+
+    void createComponentFromPropertyBag()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        new ReflectedTestingSystem(&em);
+
+        QVariantMap m;
+        m["myint"] = 4711;
+        PropertyBag bag(m);
+        QCOMPARE(bag.value(FieldNames::find("myint")).toInt(), 4711);
+        QCOMPARE(bag.toVariantMap(), m);
+
+        // system converting bag to variant map
+        Testing* t = em.createComponent<Testing>(1, bag);
+        QVERIFY(t != nullptr);
+        QCOMPARE(t->myInt(), 4711);
+
+        // system applying bag directly
+        ReflectedTesting* r = em.createComponent<ReflectedTesting>(1, bag);
+        QVERIFY(r != nullptr);
+        QCOMPARE(r->_myint, 4711);
+
+        bag.insert("myint", 815);
+        em.system(qMetaTypeId<ReflectedTesting>())->fromPropertyBag(1, bag);
+        QCOMPARE(r->_myint, 815);
+    }
+
+
+    void saveAndLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString syncPath = dir.path() + "/sync.sav";
+        QString asyncPath = dir.path() + "/async.sav";
+
+        {
+            EntityManager em;
+            new TestingSystem(&em);
+            new ReflectedTestingSystem(&em);
+            for(EntityId i = 0; i < 10; ++i)
+            {
+                EntityId eid = em.createEntityId();
+                em.createComponent<Testing>(eid)->setMyInt(int(eid));
+                ReflectedTesting* r = em.createComponent<ReflectedTesting>(eid);
+                r->_myint = int(eid) * 2;
+                r->_mytransient = "notsaved";
+            }
+            QVERIFY(em.save(syncPath));
+
+            QFuture<bool> future = em.beginAsyncSave(asyncPath);
+            // changes after taking the snapshot are not saved
+            em.component<ReflectedTesting>(1)->_myint = 4711;
+            em.destroyEntity(2);
+            QVERIFY(future.result());
+        }
+
+        QStringList paths;
+        paths << syncPath << asyncPath;
+        foreach(QString path, paths)
+        {
+            EntityManager em;
+            new TestingSystem(&em);
+            new ReflectedTestingSystem(&em);
+            QVERIFY(em.load(path));
+            QCOMPARE(em.system(qMetaTypeId<Testing>())->count(), size_t(10));
+            QCOMPARE(em.system(qMetaTypeId<ReflectedTesting>())->count(), size_t(10));
+            QCOMPARE(em.component<Testing>(2)->myInt(), 2);
+            QCOMPARE(em.component<ReflectedTesting>(1)->_myint, 2);
+            QCOMPARE(em.component<ReflectedTesting>(10)->_myint, 20);
+            QVERIFY(em.component<ReflectedTesting>(10)->_mytransient.isEmpty());
+            QCOMPARE(em.createEntityId(), EntityId(11));
+        }
+    }
+
+
+    void snapshotCopiesComponents()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString path = dir.path() + "/copies.sav";
+
+        {
+            EntityManager em;
+            TestingSystem* ts = new TestingSystem(&em);
+            ts->setSnapshotConverter(&testingToVariantMap);
+            for(EntityId i = 1; i <= 5; ++i)
+            {
+                em.createComponent<Testing>(i)->setMyInt(int(i));
+            }
+
+            std::unique_ptr<SystemSnapshot> snapshot(ts->createSnapshot());
+            QVERIFY(dynamic_cast<ComponentSnapshot<Testing>*>(snapshot.get()) != nullptr);
+
+            QFuture<bool> future = em.beginAsyncSave(path);
+            em.component<Testing>(1)->setMyInt(4711);
+            QVERIFY(future.result());
+        }
+
+        EntityManager em;
+        ContextRecordingSystem* cs = new ContextRecordingSystem(&em);
+        QVERIFY(em.load(path));
+        QCOMPARE(cs->count(), size_t(5));
+        QCOMPARE(em.component<Testing>(1)->myInt(), 1);
+        QCOMPARE(em.component<Testing>(5)->myInt(), 5);
+
+        // loaded values are applied in the context they were saved with
+        QCOMPARE(cs->_contexts.size(), 5);
+        foreach(int context, cs->_contexts)
+        {
+            QCOMPARE(context, int(EntitySystem::STORAGE));
+        }
+    }
 };
@@ -125,4 +125,60 @@ private slots:
 
         QCOMPARE(sum, 15);
     }
+
+    void reflectedConversion()
+    {
+        EntityManager em;
+        ReflectedTestingSystem* ts = new ReflectedTestingSystem(&em);
+
+        QVariantMap m;
+        m["myint"] = 666;
+        m["mycolor"] = QColor(Qt::red);
+        m["notaproperty"] = 1;
+        ReflectedTesting* c = static_cast<ReflectedTesting*>(ts->createComponent(1, m));
+        QVERIFY(c != nullptr);
+        QCOMPARE(c->_myint, 666);
+        QCOMPARE(c->myColor(), QColor(Qt::red));
+
+        QVariantMap out = ts->toVariantMap(1);
+        QCOMPARE(out.size(), 3);
+        QCOMPARE(out["myint"].toInt(), 666);
+        QCOMPARE(out["mycolor"].value<QColor>(), QColor(Qt::red));
+
+        QVariantMap stored = ts->toVariantMap(1, EntitySystem::STORAGE);
+        QVERIFY(!stored.contains("mytransient"));
+
+        QVariantMap m2;
+        m2["myint"] = 777;
+        ts->fromVariantMap(1, m2);
+        QCOMPARE(c->_myint, 777);
+        QCOMPARE(c->myColor(), QColor(Qt::red));
+
+        QVERIFY(ts->propertyTable() != nullptr);
+        QCOMPARE(ts->propertyTable()->indexOf("mycolor"), 1);
+        QCOMPARE(ts->propertyTable()->indexOf("notaproperty"), -1);
+    }
+
+    void applyPatch()
+    {
+        PropertyPath path("shapes[3].Color");
+        QCOMPARE(path.size(), 3);
+        QCOMPARE(path.field(), QString("shapes"));
+        QCOMPARE(path.at(1)._index, 3);
+        QCOMPARE(path.at(2)._name, QString("Color"));
+        QCOMPARE(path.toString(), QString("shapes[3].Color"));
+        QVERIFY(PropertyPath("[3].Color").isEmpty());
+        QVERIFY(PropertyPath("shapes..Color").isEmpty());
+        QVERIFY(PropertyPath("shapes[x]").isEmpty());
+
+        EntityManager em;
+        TestingSystem* ts = new TestingSystem(&em);
+        Testing* t = static_cast<Testing*>(ts->createComponent(1));
+
+        // default implementation only handles whole fields
+        QVERIFY(ts->applyPatch(1, PropertyPath("myint"), 42));
+        QCOMPARE(t->myInt(), 42);
+        QVERIFY(!ts->applyPatch(1, PropertyPath("myobjects[0]"), 42));
+        QVERIFY(!ts->applyPatch(2, PropertyPath("myint"), 42));
+    }
 };
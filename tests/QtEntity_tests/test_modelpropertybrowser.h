@@ -0,0 +1,223 @@
+#include <QtTest/QtTest>
+#include <QTreeView>
+#include <qteditorfactory.h>
+#include <qtmodelpropertybrowser.h>
+#include <qtpropertymanager.h>
+
+/**
+ * Item model and editors of QtModelPropertyBrowser
+ */
+class ModelPropertyBrowserTest: public QObject
+{
+    Q_OBJECT
+
+    QTreeView* view(QtModelPropertyBrowser& browser)
+    {
+        return browser.findChild<QTreeView*>();
+    }
+
+    // compare model rows below parent with browser items, recursively
+    void checkModel(QAbstractItemModel* model, const QModelIndex& parent, const QList<QtBrowserItem*>& items)
+    {
+        QCOMPARE(model->rowCount(parent), items.size());
+        for(int row = 0; row < items.size(); ++row)
+        {
+            QModelIndex index = model->index(row, 0, parent);
+            QVERIFY(index.isValid());
+            QCOMPARE(index.row(), row);
+            QCOMPARE(model->parent(index), parent);
+            QCOMPARE(model->parent(model->index(row, 1, parent)), parent);
+            QCOMPARE(index.data().toString(), items.at(row)->property()->propertyName());
+            checkModel(model, index, items.at(row)->children());
+        }
+        QVERIFY(!model->index(items.size(), 0, parent).isValid());
+    }
+
+private slots:
+
+    void insertAndRemove()
+    {
+        QtModelPropertyBrowser browser;
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+        QAbstractItemModel* model = view(browser)->model();
+
+        QtProperty* a = groups.addProperty("a");
+        QtProperty* b = groups.addProperty("b");
+        QtProperty* c = ints.addProperty("c");
+        browser.addProperty(a);
+        browser.addProperty(c);
+        browser.insertProperty(b, a);
+        checkModel(model, QModelIndex(), browser.topLevelItems());
+        QCOMPARE(model->index(1, 0).data().toString(), QString("b"));
+
+        // insert sub properties at front, middle and end
+        QtProperty* a1 = ints.addProperty("a1");
+        QtProperty* a2 = ints.addProperty("a2");
+        QtProperty* a3 = ints.addProperty("a3");
+        a->addSubProperty(a3);
+        a->insertSubProperty(a1, nullptr);
+        a->insertSubProperty(a2, a1);
+        checkModel(model, QModelIndex(), browser.topLevelItems());
+        QCOMPARE(model->index(1, 0, model->index(0, 0)).data().toString(), QString("a2"));
+
+        a->removeSubProperty(a1);
+        browser.removeProperty(b);
+        checkModel(model, QModelIndex(), browser.topLevelItems());
+        QCOMPARE(model->rowCount(), 2);
+        QCOMPARE(model->rowCount(model->index(0, 0)), 2);
+
+        browser.clear();
+        QCOMPARE(model->rowCount(), 0);
+    }
+
+    void rowHints()
+    {
+        QtModelPropertyBrowser browser;
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+        QAbstractItemModel* model = view(browser)->model();
+
+        QtProperty* root = groups.addProperty("root");
+        QList<QtProperty*> props;
+        for(int i = 0; i < 10; ++i)
+        {
+            QtProperty* group = groups.addProperty(QString("group%1").arg(i));
+            group->addSubProperty(ints.addProperty("value"));
+            props.push_back(group);
+        }
+        root->insertSubProperties(props, nullptr);
+        browser.addProperty(root);
+        checkModel(model, QModelIndex(), browser.topLevelItems());
+
+        // inserting and removing at front moves all siblings, so their row hints are stale.
+        // Parents of sub items have to be found at their new rows
+        QModelIndex rootIndex = model->index(0, 0);
+        QPersistentModelIndex leaf(model->index(0, 0, model->index(4, 0, rootIndex)));
+        QtProperty* first = groups.addProperty("first");
+        root->insertSubProperty(first, nullptr);
+        QCOMPARE(model->parent(leaf).row(), 5);
+        QCOMPARE(model->parent(leaf).data().toString(), QString("group4"));
+
+        root->removeSubProperty(first);
+        root->removeSubProperty(props.at(0));
+        QCOMPARE(model->parent(leaf).row(), 3);
+        QCOMPARE(model->parent(leaf).data().toString(), QString("group4"));
+        checkModel(model, QModelIndex(), browser.topLevelItems());
+    }
+
+    void batchInsert()
+    {
+        QtModelPropertyBrowser browser;
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+        QAbstractItemModel* model = view(browser)->model();
+
+        QtProperty* root = groups.addProperty("root");
+        QtProperty* last = ints.addProperty("last");
+        root->addSubProperty(last);
+        browser.addProperty(root);
+
+        QList<QtProperty*> props;
+        for(int i = 0; i < 5; ++i)
+        {
+            props.push_back(ints.addProperty(QString("value%1").arg(i)));
+        }
+
+        // all properties are inserted as a single range of rows
+        int notifications = 0;
+        connect(&groups, &QtAbstractPropertyManager::propertiesInserted, [&notifications]() { ++notifications; });
+        QSignalSpy rowSpy(model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+        root->insertSubProperties(props, nullptr);
+        QCOMPARE(notifications, 1);
+        QCOMPARE(rowSpy.count(), 1);
+        QCOMPARE(rowSpy.first().at(1).toInt(), 0);
+        QCOMPARE(rowSpy.first().at(2).toInt(), 4);
+        checkModel(model, QModelIndex(), browser.topLevelItems());
+        QCOMPARE(model->index(5, 0, model->index(0, 0)).data().toString(), QString("last"));
+    }
+
+    void autoExpand()
+    {
+        QtModelPropertyBrowser browser;
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+
+        QtProperty* group = groups.addProperty("group");
+        group->addSubProperty(ints.addProperty("value"));
+        QtProperty* empty = groups.addProperty("empty");
+        QtProperty* leaf = ints.addProperty("leaf");
+        QtBrowserItem* groupItem = browser.addProperty(group);
+        QtBrowserItem* emptyItem = browser.addProperty(empty);
+        QtBrowserItem* leafItem = browser.addProperty(leaf);
+
+        // items with sub properties are expanded, others are not
+        QVERIFY(browser.isExpanded(groupItem));
+        QVERIFY(!browser.isExpanded(emptyItem));
+        QVERIFY(!browser.isExpanded(leafItem));
+        QVERIFY(!browser.isExpanded(groupItem->children().first()));
+
+        // first sub property expands its parent
+        empty->addSubProperty(ints.addProperty("value"));
+        QVERIFY(browser.isExpanded(emptyItem));
+
+        browser.setExpanded(groupItem, false);
+        QVERIFY(!browser.isExpanded(groupItem));
+    }
+
+    void childIndicator()
+    {
+        QtModelPropertyBrowser browser;
+        QtGroupPropertyManager groups;
+        QAbstractItemModel* model = view(browser)->model();
+
+        QtBrowserItem* item = browser.addProperty(groups.addProperty("list"));
+        QModelIndex index = model->index(0, 0);
+        QVERIFY(!model->hasChildren(index));
+        browser.setChildIndicatorShown(item, true);
+        QVERIFY(model->hasChildren(index));
+        QCOMPARE(model->rowCount(index), 0);
+        QVERIFY(!model->hasChildren(model->index(0, 1)));
+        browser.setChildIndicatorShown(item, false);
+        QVERIFY(!model->hasChildren(index));
+    }
+
+    void singleEditor()
+    {
+        QtModelPropertyBrowser browser;
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+        QtSpinBoxFactory factory;
+        browser.setFactoryForManager(&ints, &factory);
+        QTreeView* treeview = view(browser);
+        QAbstractItemModel* model = treeview->model();
+
+        QtBrowserItem* a = browser.addProperty(ints.addProperty("a"));
+        QtBrowserItem* b = browser.addProperty(ints.addProperty("b"));
+        QtBrowserItem* group = browser.addProperty(groups.addProperty("group"));
+        QVERIFY(treeview->indexWidget(model->index(0, 1)) == nullptr);
+
+        // editor is opened for the value of the current row only
+        browser.setCurrentItem(a);
+        QCOMPARE(treeview->currentIndex().row(), 0);
+        QVERIFY(treeview->indexWidget(model->index(0, 1)) != nullptr);
+        QVERIFY(treeview->indexWidget(model->index(1, 1)) == nullptr);
+
+        browser.setCurrentItem(b);
+        QVERIFY(treeview->indexWidget(model->index(0, 1)) == nullptr);
+        QVERIFY(treeview->indexWidget(model->index(1, 1)) != nullptr);
+
+        // current item follows the view
+        treeview->setCurrentIndex(model->index(0, 0));
+        QCOMPARE(browser.currentItem(), a);
+        QVERIFY(treeview->indexWidget(model->index(0, 1)) != nullptr);
+        QVERIFY(treeview->indexWidget(model->index(1, 1)) == nullptr);
+
+        // properties without value get no editor
+        browser.setCurrentItem(group);
+        for(int row = 0; row < model->rowCount(); ++row)
+        {
+            QVERIFY(treeview->indexWidget(model->index(row, 1)) == nullptr);
+        }
+    }
+};
@@ -220,7 +220,43 @@ private slots:
         ts->createComponent(1);
         QCOMPARE(ts->count(), (size_t)1);
     }
-    
+
+    void memoryStats()
+    {
+        EntityManager em;
+        TestingSystemPooled* pooled = new TestingSystemPooled(&em, 10);
+        TestingSystem* simple = new TestingSystem(&em);
+        for(int i = 1; i <= 4; ++i)
+        {
+            pooled->createComponent(i);
+            simple->createComponent(i);
+        }
+
+        MemoryStats ps = pooled->memoryStats();
+        QCOMPARE(ps._count, (size_t)4);
+        QVERIFY(ps._liveBytes >= 4 * sizeof(Testing));
+        QVERIFY(ps._reservedBytes > ps._liveBytes);
+        QVERIFY(ps._indexBytes > 0);
+        QVERIFY(ps.fragmentation() > 0.5);
+
+        MemoryStats ss = simple->memoryStats();
+        QCOMPARE(ss._count, (size_t)4);
+        QVERIFY(ss._reservedBytes >= ss._liveBytes);
+        QVERIFY(ss._indexBytes > 0);
+
+        MemoryStats total = em.memoryStats();
+        QCOMPARE(total._count, ps._count + ss._count);
+        QCOMPARE(total._liveBytes, ps._liveBytes + ss._liveBytes);
+        QCOMPARE(total._reservedBytes, ps._reservedBytes + ss._reservedBytes);
+        QCOMPARE(total._indexBytes, ps._indexBytes + ss._indexBytes);
+        QCOMPARE(total.totalBytes(), ps.totalBytes() + ss.totalBytes());
+
+        // reserved capacity is kept when components are destroyed
+        pooled->destroyComponent(1);
+        QCOMPARE(pooled->memoryStats()._reservedBytes, ps._reservedBytes);
+        QVERIFY(pooled->memoryStats().fragmentation() > ps.fragmentation());
+    }
+
     void speedTest()
     {
         {
@@ -1,13 +1,35 @@
 #include <QtTest/QtTest>
 #include <QtCore/QObject>
+#include <QtEntityUtils/PrefabLibrary>
 #include <QtEntityUtils/PrefabSystem>
 #include <QtEntity/EntityManager>
+#include <QTemporaryDir>
 #include "common.h"
 
 using namespace QtEntity;
 using namespace QtEntityUtils;
 
 
+// remembers the properties passed to createComponent, like systems
+// that read their properties at creation
+class CreationRecordingSystem : public TestingSystem
+{
+public:
+    CreationRecordingSystem(QtEntity::EntityManager* em)
+        : TestingSystem(em)
+    {
+    }
+
+    virtual void* createComponent(QtEntity::EntityId id, const QVariantMap& properties = QVariantMap()) override
+    {
+        _created[id] = properties;
+        return TestingSystem::createComponent(id, properties);
+    }
+
+    QHash<QtEntity::EntityId, QVariantMap> _created;
+};
+
+
 class PrefabSystemTest: public QObject
 {
     Q_OBJECT
@@ -141,4 +163,144 @@ private slots:
         QCOMPARE(6789, test->myInt());
     }
 
+
+    void libraryLazyLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QDir(dir.path()).mkpath("prefabs/enemies");
+        QFile file(dir.path() + "/prefabs/enemies/bat.json");
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("{ \"components\": { \"Testing\": { \"myint\": 12345 } }, \"parameters\": [ \"myint\" ] }");
+        file.close();
+
+        PrefabLibrary library;
+        library.setCacheDirectory(dir.path() + "/cache");
+        QCOMPARE(library.indexDirectory(dir.path() + "/prefabs"), 1);
+        QVERIFY(library.contains("enemies/bat"));
+
+        EntityManager em;
+        PrefabSystem* ps = new PrefabSystem(&em);
+        new TestingSystem(&em);
+        ps->setPrefabLibrary(&library);
+
+        // not loaded before first instantiation
+        QVERIFY(ps->prefab("enemies/bat") == nullptr);
+        QVERIFY(!QDir(dir.path() + "/cache").exists());
+
+        QVariantMap props;
+        props["path"] = "enemies/bat";
+        QVERIFY(em.createComponent<PrefabInstance>(1, props) != nullptr);
+
+        auto test = em.component<Testing>(1);
+        QVERIFY(test != nullptr);
+        QCOMPARE(test->myInt(), 12345);
+        QVERIFY(ps->prefab("enemies/bat") != nullptr);
+        QCOMPARE(ps->prefab("enemies/bat")->parameters(), QStringList() << "myint");
+
+        // binary cache was written and yields same data
+        QCOMPARE(QDir(dir.path() + "/cache").entryList(QDir::Files).size(), 1);
+        QVariantMap components;
+        QStringList parameters;
+        QVERIFY(library.load("enemies/bat", components, parameters));
+        QCOMPARE(components["Testing"].toMap()["myint"].toInt(), 12345);
+        QCOMPARE(parameters, QStringList() << "myint");
+    }
+
+
+    void libraryReadsCache()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QDir(dir.path()).mkpath("prefabs");
+        QFile bat(dir.path() + "/prefabs/bat.json");
+        QVERIFY(bat.open(QIODevice::WriteOnly));
+        bat.write("{ \"components\": { \"Testing\": { \"myint\": 12345 } } }");
+        bat.close();
+        QFile rat(dir.path() + "/prefabs/rat.json");
+        QVERIFY(rat.open(QIODevice::WriteOnly));
+        rat.write("{ \"components\": { \"Testing\": { \"myint\": 999 } } }");
+        rat.close();
+
+        PrefabLibrary library;
+        library.setCacheDirectory(dir.path() + "/cache");
+        QCOMPARE(library.indexDirectory(dir.path() + "/prefabs"), 2);
+
+        QVariantMap components;
+        QStringList parameters;
+        QVERIFY(library.load("bat", components, parameters));
+        QDir cache(dir.path() + "/cache");
+        QStringList batCache = cache.entryList(QDir::Files);
+        QCOMPARE(batCache.size(), 1);
+        QVERIFY(library.load("rat", components, parameters));
+        QStringList ratCache = cache.entryList(QDir::Files);
+        QCOMPARE(ratCache.size(), 2);
+        ratCache.removeAll(batCache.first());
+
+        // replace cache entry of bat with that of rat, bat.json keeps its contents
+        // so the cache key stays valid. Loading bat has to return the cached data
+        QVERIFY(QFile::remove(cache.filePath(batCache.first())));
+        QVERIFY(QFile::copy(cache.filePath(ratCache.first()), cache.filePath(batCache.first())));
+        QVERIFY(library.load("bat", components, parameters));
+        QCOMPARE(components["Testing"].toMap()["myint"].toInt(), 999);
+
+        // an invalid cache entry is ignored and the prefab file is parsed again
+        QFile corrupt(cache.filePath(batCache.first()));
+        QVERIFY(corrupt.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        corrupt.write("invalid");
+        corrupt.close();
+        QVERIFY(library.load("bat", components, parameters));
+        QCOMPARE(components["Testing"].toMap()["myint"].toInt(), 12345);
+    }
+
+
+    void systemRegisteredAfterPrefab()
+    {
+        EntityManager em;
+        PrefabSystem* ps = new PrefabSystem(&em);
+
+        QVariantMap mycomponent;
+        mycomponent["myint"] = 12345;
+        QVariantMap components;
+        components["Testing"] = mycomponent;
+        ps->addPrefab("bla.prefab", components);
+
+        // component type is resolved when the prefab is instantiated
+        new TestingSystem(&em);
+        QVariantMap props;
+        props["path"] = "bla.prefab";
+        QVERIFY(ps->createComponent(1, props) != nullptr);
+        Testing* test = em.component<Testing>(1);
+        QVERIFY(test != nullptr);
+        QCOMPARE(test->myInt(), 12345);
+    }
+
+
+    void createPassesPropertiesToSystem()
+    {
+        EntityManager em;
+        PrefabSystem* ps = new PrefabSystem(&em);
+        CreationRecordingSystem* ts = new CreationRecordingSystem(&em);
+
+        QVariantMap mycomponent;
+        mycomponent["myint"] = 12345;
+        QVariantMap components;
+        components["Testing"] = mycomponent;
+        ps->addPrefab("bla.prefab", components);
+
+        QVariantMap props;
+        props["path"] = "bla.prefab";
+        QVERIFY(ps->createComponent(1, props) != nullptr);
+        QVERIFY(ps->createComponentFromBag(2, PropertyBag(props)) != nullptr);
+
+        // systems without property table get the values at creation
+        QCOMPARE(ts->_created.value(1), mycomponent);
+        QCOMPARE(ts->_created.value(2), mycomponent);
+        QCOMPARE(em.component<Testing>(2)->myInt(), 12345);
+
+        // same when creating from a bag directly
+        QVERIFY(ts->createComponentFromBag(3, PropertyBag(mycomponent)) != nullptr);
+        QCOMPARE(ts->_created.value(3), mycomponent);
+    }
+
 };
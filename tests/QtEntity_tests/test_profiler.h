@@ -0,0 +1,88 @@
+#include <QtTest/QtTest>
+#include <QtCore/QObject>
+#include <QtEntity/Profiler>
+#include <QJsonDocument>
+#include <QThread>
+
+using namespace QtEntity;
+
+
+// records a zone from another thread
+class ProfiledThread : public QThread
+{
+protected:
+    virtual void run() override
+    {
+        qint64 start = Profiler::now();
+        Profiler::record("worker", start, start + 1000);
+    }
+};
+
+
+class ProfilerTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void init()
+    {
+        Profiler::clear();
+    }
+
+    void frameSummary()
+    {
+        Profiler::record("before frame", Profiler::now(), Profiler::now());
+
+        Profiler::beginFrame();
+        qint64 start = Profiler::now();
+        Profiler::record("a", start, start + 100);
+        Profiler::record("a", start, start + 300);
+        Profiler::record("b", start, start + 50);
+        ProfiledThread thread;
+        thread.start();
+        thread.wait();
+        Profiler::endFrame();
+
+        QVector<ProfileZoneStats> stats = Profiler::frameSummary();
+        QCOMPARE(stats.size(), 3);
+        QCOMPARE(stats[0]._name, QString("worker"));
+        QCOMPARE(stats[1]._name, QString("a"));
+        QCOMPARE(stats[1]._count, 2);
+        QCOMPARE(stats[1]._totalNs, qint64(400));
+        QCOMPARE(stats[1]._maxNs, qint64(300));
+        QVERIFY(Profiler::frameTime() > 0);
+
+        // events of last frame are not counted again
+        Profiler::beginFrame();
+        Profiler::endFrame();
+        QVERIFY(Profiler::frameSummary().isEmpty());
+    }
+
+    void chromeTrace()
+    {
+        qint64 start = Profiler::now();
+        Profiler::record("zone \"quoted\"", start, start + 2000);
+        Profiler::setEnabled(false);
+        Profiler::record("disabled", start, start + 2000);
+        Profiler::setEnabled(true);
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(Profiler::chromeTrace(), &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QByteArray trace = Profiler::chromeTrace();
+        QVERIFY(trace.contains("zone \\\"quoted\\\""));
+        QVERIFY(!trace.contains("disabled"));
+        QVERIFY(trace.contains("\"dur\":2.000"));
+    }
+
+    void internName()
+    {
+        // interned names stay valid after the string they were built from is gone
+        const char* name = Profiler::internName(QString("zone%1").arg(42));
+        QVERIFY(Profiler::internName("zone42") == name);
+        qint64 start = Profiler::now();
+        Profiler::record(name, start, start + 1000);
+        QVERIFY(Profiler::chromeTrace().contains("\"zone42\""));
+    }
+};
@@ -0,0 +1,82 @@
+#include <QtTest/QtTest>
+#include <qtpropertymanager.h>
+
+/**
+ * Property manager storage and sub property insertion.
+ * Timings with many properties are measured by qtentity_bench
+ */
+class PropertyManagerTest: public QObject
+{
+    Q_OBJECT
+
+    static const int NUM_PROPERTIES = 2000;
+
+    // create properties as children of a few groups
+    QList<QtProperty*> createProperties(QtGroupPropertyManager& groups, QtIntPropertyManager& ints)
+    {
+        QList<QtProperty*> ret;
+        QtProperty* group = nullptr;
+        for(int i = 0; i < NUM_PROPERTIES; ++i)
+        {
+            if(i % 1000 == 0)
+            {
+                group = groups.addProperty(QString("group%1").arg(i / 1000));
+                ret.push_back(group);
+            }
+            QtProperty* prop = ints.addProperty("value");
+            group->addSubProperty(prop);
+            ret.push_back(prop);
+        }
+        return ret;
+    }
+
+private slots:
+
+    void create()
+    {
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+        createProperties(groups, ints);
+        QCOMPARE(ints.properties().size(), NUM_PROPERTIES);
+        QCOMPARE(groups.properties().size(), NUM_PROPERTIES / 1000);
+    }
+
+    void update()
+    {
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+        QList<QtProperty*> props = createProperties(groups, ints);
+        int i = 0;
+        foreach(QtProperty* prop, props)
+        {
+            ints.setValue(prop, ++i);
+        }
+        QCOMPARE(ints.value(props.last()), props.size());
+    }
+
+    void destroy()
+    {
+        QtGroupPropertyManager groups;
+        QtIntPropertyManager ints;
+        QList<QtProperty*> props = createProperties(groups, ints);
+        qDeleteAll(props);
+        QVERIFY(ints.properties().isEmpty());
+        QVERIFY(groups.properties().isEmpty());
+    }
+
+    void insertSubProperties()
+    {
+        QtGroupPropertyManager groups;
+        QtProperty* root = groups.addProperty("root");
+        QtProperty* a = groups.addProperty("a");
+        QtProperty* b = groups.addProperty("b");
+        QtProperty* c = groups.addProperty("c");
+        root->addSubProperty(c);
+        root->insertSubProperties(QList<QtProperty*>() << a << b << c, nullptr);
+        QCOMPARE(root->subProperties(), QList<QtProperty*>() << a << b << c);
+
+        // cycles are rejected
+        a->insertSubProperties(QList<QtProperty*>() << root << a, nullptr);
+        QVERIFY(a->subProperties().isEmpty());
+    }
+};
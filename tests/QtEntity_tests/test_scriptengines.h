@@ -0,0 +1,113 @@
+#include <QtTest/QtTest>
+#include <QtEntity/EntityManager>
+#include <QtEntityScript/JSBindings>
+#include <QtEntityScript/ScriptBindings>
+#include <QJSEngine>
+#include <QScriptEngine>
+#include "common.h"
+using namespace QtEntity;
+
+/**
+ * Runs the same scripts with QtScript and QJSEngine bindings.
+ * Timings of both engines are measured by qtentity_bench
+ */
+class ScriptEnginesTest: public QObject
+{
+    Q_OBJECT
+
+    // evaluate code in engine selected by test data, return result as int
+    int evaluate(EntityManager& em, const QString& code)
+    {
+        QFETCH(QString, engine);
+        int result = 0;
+        if(engine == "QtScript")
+        {
+            QScriptEngine e;
+            QtEntityScript::exposeEntityManager(&e, &em);
+            result = e.evaluate(code).toInt32();
+            if(e.hasUncaughtException()) qDebug() << "Script error: " << e.uncaughtException().toString();
+        }
+        else
+        {
+            QJSEngine e;
+            QtEntityScript::exposeEntityManager(&e, &em);
+            QJSValue ret = e.evaluate(code);
+            if(ret.isError()) qDebug() << "Script error: " << ret.toString();
+            result = ret.toInt();
+        }
+        return result;
+    }
+
+    void engineData()
+    {
+        QTest::addColumn<QString>("engine");
+        QTest::newRow("QtScript") << "QtScript";
+        QTest::newRow("QJSEngine") << "QJSEngine";
+    }
+
+private slots:
+
+    void sameApi_data() { engineData(); }
+    void sameApi()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        new ReflectedTestingSystem(&em);
+        int ret = evaluate(em,
+            "var id = EM.createEntityId();"
+            "EM.ReflectedTesting.createComponent(id, {myint: 5});"
+            "EM.Testing.createComponent(id, {myint: 7});"
+            "var r = EM.ReflectedTesting.get(id);"
+            "var t = EM.Testing.get(id);"
+            "r.myint += 10; t.myint += 20;"
+            "EM.ReflectedTesting.toVariantMap(id).myint + EM.Testing.toVariantMap(id).myint + EM.Testing.count();");
+        QCOMPARE(ret, 15 + 27 + 1);
+        QCOMPARE(em.component<ReflectedTesting>(1)->_myint, 15);
+        QCOMPARE(em.component<Testing>(1)->myInt(), 27);
+    }
+
+    void createDestroy_data() { engineData(); }
+    void createDestroy()
+    {
+        EntityManager em;
+        new ReflectedTestingSystem(&em);
+        int ret = evaluate(em,
+            "for(var i = 1; i <= 10; ++i) EM.ReflectedTesting.createComponent(i, {myint: i});"
+            "var n = EM.ReflectedTesting.count();"
+            "for(var i = 1; i <= 5; ++i) EM.ReflectedTesting.destroyComponent(i);"
+            "n");
+        QCOMPARE(ret, 10);
+        QCOMPARE(em.system(qMetaTypeId<ReflectedTesting>())->count(), size_t(5));
+        QCOMPARE(em.component<ReflectedTesting>(7)->_myint, 7);
+    }
+
+    void propertyAccess_data() { engineData(); }
+    void propertyAccess()
+    {
+        EntityManager em;
+        new ReflectedTestingSystem(&em);
+        em.createComponent<ReflectedTesting>(1);
+        int ret = evaluate(em,
+            "var c = EM.ReflectedTesting.get(1);"
+            "for(var i = 0; i < 10; ++i) c.myint = c.myint + 1;"
+            "c.myint");
+        QCOMPARE(ret, 10);
+        QCOMPARE(em.component<ReflectedTesting>(1)->_myint, 10);
+    }
+
+    void variantMapAccess_data() { engineData(); }
+    void variantMapAccess()
+    {
+        EntityManager em;
+        new ReflectedTestingSystem(&em);
+        em.createComponent<ReflectedTesting>(1);
+        int ret = evaluate(em,
+            "for(var i = 0; i < 10; ++i) {"
+            "    var m = EM.ReflectedTesting.toVariantMap(1);"
+            "    EM.ReflectedTesting.fromVariantMap(1, {myint: m.myint + 1});"
+            "}"
+            "EM.ReflectedTesting.toVariantMap(1).myint");
+        QCOMPARE(ret, 10);
+        QCOMPARE(em.component<ReflectedTesting>(1)->_myint, 10);
+    }
+};
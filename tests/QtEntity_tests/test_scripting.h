@@ -1,17 +1,19 @@
 #include <QtTest/QtTest>
 #include <QtEntity/EntityManager>
+#include <QtEntityScript/ScriptBindings>
+#include <QtEntityScript/ScriptComponentSystem>
+#include <QtEntityScript/ScriptProfiler>
+#include <QtEntityScript/ScriptSystemRunner>
 #include <QScriptEngine>
+#include <QTemporaryDir>
 #include "common.h"
 using namespace QtEntity;
 
-inline QScriptValue entityIdToScriptValue(QScriptEngine *engine, const QtEntity::EntityId &s)
+inline bool writeScript(const QString& path, const QString& source)
 {
-  return engine->newVariant(s);
-}
-
-inline void entityIdFromScriptValue(const QScriptValue &obj, QtEntity::EntityId &s)
-{
-    s = obj.toUInt32();
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+    return file.write(source.toUtf8()) != -1;
 }
 
 
@@ -23,18 +25,14 @@ public:
 
     EntityManager _em;
     TestingSystem* _ts;
+    ReflectedTestingSystem* _rts;
     QScriptEngine _engine;
 
     ScriptingTest()
     {
-        qRegisterMetaType<QtEntity::EntityId>("QtEntity::EntityId");
         _ts = new TestingSystem(&_em);
-        QScriptValue objectValue = _engine.newQObject(&_em);
-        _engine.globalObject().setProperty("EM", objectValue);
-        qScriptRegisterMetaType(&_engine, entityIdToScriptValue, entityIdFromScriptValue);
-        
-        EntitySystemPrototype* esProto = new EntitySystemPrototype();
-        _engine.setDefaultPrototype(qMetaTypeId<QtEntity::EntitySystem*>(), _engine.newQObject(esProto));
+        _rts = new ReflectedTestingSystem(&_em);
+        QtEntityScript::exposeEntityManager(&_engine, &_em);
     }
 
 
@@ -108,5 +106,183 @@ private slots:
         }
         QCOMPARE(ret2.toInt32(), 6789);
     }
-};
 
+    void testComponentProxy()
+    {
+        QVariantMap m; m["myint"] = 12345;
+        _ts->createComponent(997, m);
+        ReflectedTesting* r = static_cast<ReflectedTesting*>(_rts->createComponent(997, m));
+
+        // system with property table
+        QScriptValue ret = _engine.evaluate("var c = EM.ReflectedTesting.get(997); c.myint += 1; c.myint;");
+        if(_engine.hasUncaughtException())
+        {
+            qDebug() << "Script error: " << _engine.uncaughtException().toString();
+        }
+        QCOMPARE(ret.toInt32(), 12346);
+        QCOMPARE(r->_myint, 12346);
+
+        // system converting to and from variant maps
+        ret = _engine.evaluate("var t = EM.Testing.get(997); t.myint = 6789; t.myint;");
+        if(_engine.hasUncaughtException())
+        {
+            qDebug() << "Script error: " << _engine.uncaughtException().toString();
+        }
+        QCOMPARE(ret.toInt32(), 6789);
+        Testing* t;
+        QVERIFY(_ts->component(997, t));
+        QCOMPARE(t->myInt(), 6789);
+
+        // unknown fields and missing components
+        ret = _engine.evaluate("EM.ReflectedTesting.get(997).nofield === undefined && EM.ReflectedTesting.get(996) === null;");
+        QVERIFY(ret.toBool());
+
+        _rts->destroyComponent(997);
+        ret = _engine.evaluate("c.myint === undefined;");
+        QVERIFY(ret.toBool());
+    }
+
+    void testScriptSystemRunner()
+    {
+        EntityManager em;
+        TestingSystem* ts = new TestingSystem(&em);
+        ReflectedTestingSystem* rts = new ReflectedTestingSystem(&em);
+        QScriptEngine engine;
+        QtEntityScript::exposeEntityManager(&engine, &em);
+        QtEntityScript::ScriptSystemRunner runner(&engine, &em);
+        engine.globalObject().setProperty("Systems", engine.newQObject(&runner));
+
+        for(EntityId i = 1; i <= 100; ++i)
+        {
+            QVariantMap m; m["myint"] = int(i);
+            ts->createComponent(i, m);
+            rts->createComponent(i, m);
+        }
+
+        engine.evaluate(
+            "var calls = 0;"
+            "function tick(batch, dt) {"
+            "    ++calls;"
+            "    for(var i = 0; i < batch.length; ++i) {"
+            "        if(batch.ids[i] % 2 == 0) batch.myint[i] += dt;"
+            "    }"
+            "}"
+            "Systems.addSystem('ReflectedTesting', ['myint'], tick);"
+            "Systems.addSystem('Testing', ['myint'], tick);"
+        );
+        if(engine.hasUncaughtException())
+        {
+            qDebug() << "Script error: " << engine.uncaughtException().toString();
+        }
+
+        runner.tick(10);
+        runner.tick(10);
+        QCOMPARE(engine.evaluate("calls").toInt32(), 4);
+
+        for(EntityId i = 1; i <= 100; ++i)
+        {
+            int expected = (i % 2 == 0) ? int(i) + 20 : int(i);
+            QCOMPARE(em.component<ReflectedTesting>(i)->_myint, expected);
+            QCOMPARE(em.component<Testing>(i)->myInt(), expected);
+        }
+    }
+
+    void testScriptComponentSystem()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString path = dir.path() + "/counter.js";
+        QString path2 = dir.path() + "/counter2.js";
+        QString source = "({ update: function(id, dt) { calls += dt; } })";
+        QVERIFY(writeScript(path, source));
+        QVERIFY(writeScript(path2, source));
+
+        EntityManager em;
+        QScriptEngine engine;
+        QtEntityScript::ScriptComponentSystem* scs = new QtEntityScript::ScriptComponentSystem(&em, &engine);
+        engine.globalObject().setProperty("calls", 0);
+
+        QVariantMap m; m["path"] = path;
+        for(EntityId i = 1; i <= 3; ++i)
+        {
+            QVERIFY(scs->createComponent(i, m) != nullptr);
+        }
+        m["path"] = path2;
+        scs->createComponent(4, m);
+
+        // same source is compiled once
+        QCOMPARE(scs->programCache().size(), 1);
+        QtEntityScript::ScriptComponent* c1 = em.component<QtEntityScript::ScriptComponent>(1);
+        QtEntityScript::ScriptComponent* c3 = em.component<QtEntityScript::ScriptComponent>(3);
+        QCOMPARE(c1->script(), c3->script());
+
+        scs->tick(1);
+        QCOMPARE(engine.globalObject().property("calls").toInt32(), 4);
+
+        // unchanged file is not reevaluated
+        QCOMPARE(scs->reloadScripts(), 0);
+
+        QVERIFY(writeScript(path, "({ update: function(id, dt) { calls += 10 * dt; } })"));
+        QVERIFY(scs->reloadScript(path));
+        QCOMPARE(scs->programCache().size(), 2);
+        scs->tick(1);
+        QCOMPARE(engine.globalObject().property("calls").toInt32(), 4 + 30 + 1);
+    }
+
+    void testScriptProfiler()
+    {
+        EntityManager em;
+        new TestingSystem(&em);
+        QScriptEngine engine;
+        QtEntityScript::exposeEntityManager(&engine, &em);
+        QtEntityScript::ScriptProfiler profiler(&engine);
+
+        engine.evaluate("function spawn(id) { EM.Testing.createComponent(id, {myint: id}); }", "spawn.js");
+        profiler.beginFrame();
+        engine.evaluate("for(var i = 1; i <= 10; ++i) spawn(i);");
+        profiler.endFrame();
+
+        QCOMPARE(profiler.frames().size(), 1);
+        bool foundSpawn = false, foundCreate = false;
+        foreach(const QtEntityScript::ScriptProfiler::FunctionStats& s, profiler.frames().last()._functions)
+        {
+            if(s._name.startsWith("spawn (spawn.js:1)"))
+            {
+                foundSpawn = true;
+                QCOMPARE(s._calls, 10);
+            }
+            if(s._name == "createComponent")
+            {
+                foundCreate = true;
+                QCOMPARE(s._calls, 10);
+            }
+        }
+        QVERIFY(foundSpawn);
+        QVERIFY(foundCreate);
+
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(profiler.writeChromeTrace(&buffer));
+        QJsonDocument doc = QJsonDocument::fromJson(buffer.data());
+        QVERIFY(doc.object()["traceEvents"].toArray().size() >= 21);
+    }
+
+    void testScriptProfilerClear()
+    {
+        QScriptEngine engine;
+        QtEntityScript::ScriptProfiler profiler(&engine);
+
+        // zone entered before clear is not counted when it ends
+        profiler.beginZone("outer");
+        profiler.clear();
+        profiler.beginFrame();
+        profiler.beginZone("inner");
+        profiler.endZone();
+        profiler.endZone();
+        profiler.endFrame();
+
+        QCOMPARE(profiler.frames().size(), 1);
+        QCOMPARE(profiler.frames().last()._functions.size(), 1);
+        QCOMPARE(profiler.frames().last()._functions.first()._name, QString("inner"));
+    }
+};
@@ -0,0 +1,105 @@
+#include "allocationtracker.h"
+
+#ifdef QTENTITY_TRACK_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+// plain counters, thread_local variables with trivial types need no initialization
+// and are safe to use from inside malloc
+static thread_local quint64 s_allocations = 0;
+static thread_local quint64 s_bytes = 0;
+
+static inline void countAllocation(size_t size)
+{
+    ++s_allocations;
+    s_bytes += size;
+}
+
+#if defined(__GLIBC__)
+
+// operator new of libstdc++ calls malloc, so counting malloc covers both
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t num, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+
+    void* malloc(size_t size)
+    {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t num, size_t size)
+    {
+        countAllocation(num * size);
+        return __libc_calloc(num, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        countAllocation(size);
+        return __libc_realloc(ptr, size);
+    }
+}
+
+#else
+
+void* operator new(size_t size)
+{
+    countAllocation(size);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if(p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+
+bool AllocationTracker::isAvailable()
+{
+    return true;
+}
+
+
+AllocationCount AllocationTracker::current()
+{
+    AllocationCount c;
+    c._allocations = s_allocations;
+    c._bytes = s_bytes;
+    return c;
+}
+
+#else
+
+bool AllocationTracker::isAvailable()
+{
+    return false;
+}
+
+
+AllocationCount AllocationTracker::current()
+{
+    return AllocationCount();
+}
+
+#endif
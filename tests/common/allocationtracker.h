@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * Heap allocation counters for the test and benchmark executables.
+ * When built with QTENTITY_TRACK_ALLOCATIONS, allocationtracker.cpp replaces
+ * the global allocation functions and counts allocations per thread.
+ * On glibc malloc itself is counted, so allocations made by Qt containers
+ * are included. On other platforms only operator new is counted.
+ */
+struct AllocationCount
+{
+    AllocationCount() : _allocations(0), _bytes(0) {}
+
+    quint64 _allocations;
+    quint64 _bytes;
+};
+
+
+class AllocationTracker
+{
+public:
+
+    /**
+     * @return true if allocations are counted in this build
+     */
+    static bool isAvailable();
+
+    /**
+     * @return allocations done by the calling thread since it started
+     */
+    static AllocationCount current();
+};
+
+
+/**
+ * Counts allocations of the calling thread between construction and call to count()
+ */
+class AllocationScope
+{
+public:
+
+    AllocationScope()
+        : _start(AllocationTracker::current())
+    {
+    }
+
+    AllocationCount count() const
+    {
+        AllocationCount now = AllocationTracker::current();
+        AllocationCount c;
+        c._allocations = now._allocations - _start._allocations;
+        c._bytes = now._bytes - _start._bytes;
+        return c;
+    }
+
+private:
+
+    AllocationCount _start;
+};